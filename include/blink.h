@@ -1,5 +1,5 @@
 #define BLINK_FRAMES 12
-const unsigned char blink[12] [1024] PROGMEM = {
+const unsigned char blink[12] [1024] PROGMEM __attribute__((aligned(4))) = {
 
 	// 'sprite_00, 128x64px
 
@@ -1,5 +1,5 @@
 #define DIZZY_FRAMES 3
-const unsigned char dizzy[3] [1024] PROGMEM = {
+const unsigned char dizzy[3] [1024] PROGMEM __attribute__((aligned(4))) = {
 
 	// '999afdd4d4464263eee06365649dcf6fUZcmWBe9BzoD57f5-0, 128x64px
 
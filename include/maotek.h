@@ -1,4 +1,4 @@
-const unsigned char maotek [1024] PROGMEM = {
+const unsigned char maotek [1024] PROGMEM __attribute__((aligned(4))) = {
 	// 'maotek, 128x64px
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -1,6 +1,6 @@
 #define MEMESLEN 3
 
-const unsigned char memes[3][1024] PROGMEM = {
+const unsigned char memes[3][1024] PROGMEM __attribute__((aligned(4))) = {
 
     // 'weli, 128x64px
 
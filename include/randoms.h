@@ -1,6 +1,6 @@
 #define RANDOM_COUNT 1
 
-const unsigned char randoms[1] [1024] PROGMEM = {
+const unsigned char randoms[1] [1024] PROGMEM __attribute__((aligned(4))) = {
 
 	// 'random1, 128x64px
 
@@ -0,0 +1,75 @@
+// Generated by tools/replay.py from "synth petting --minutes 1", do not edit
+const unsigned char scenario[1137] PROGMEM = {
+	0x4d, 0x52, 0x45, 0x43, 0x01, 0xd2, 0x04, 0x00, 0x00, 0x02, 0x00, 0x00, 0xa5, 0x3a, 0xc0, 0xb9,
+	0xa0, 0x01, 0x63, 0xbd, 0x66, 0x3f, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0xb9, 0x54, 0xdb, 0xbc, 0xd8,
+	0x3c, 0x73, 0x3d, 0x9c, 0x3e, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x12, 0x52, 0xdd, 0xbc, 0x55, 0x54,
+	0x4c, 0x3d, 0x25, 0xa5, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x7b, 0x2f, 0xd5, 0x3d, 0x34, 0x4d, 0x8e,
+	0x3d, 0x20, 0x39, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x69, 0xaf, 0xda, 0xba, 0xc6, 0xc1, 0xbb, 0x3d,
+	0xaa, 0x2d, 0x1d, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00,
+	0x02, 0x02, 0x03, 0xdb, 0x7a, 0xb1, 0xbc, 0xeb, 0x74, 0xde, 0xb9, 0x93, 0x0f, 0x1d, 0x41, 0x02,
+	0xe8, 0x03, 0x58, 0x1b, 0xf5, 0xbb, 0xa9, 0xbe, 0xb3, 0xbc, 0xc3, 0x8a, 0x1b, 0x41, 0x02, 0xe8,
+	0x03, 0x63, 0x4e, 0x65, 0xbc, 0x0b, 0x75, 0x1e, 0x3d, 0x72, 0x87, 0x1c, 0x41, 0x01, 0x00, 0x00,
+	0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x94, 0x32, 0x73, 0xbb,
+	0xb9, 0x3b, 0xa4, 0x3c, 0x46, 0x3a, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x05, 0x9c, 0x96, 0x3d, 0x2e,
+	0xcd, 0x6c, 0xbd, 0x3a, 0xb6, 0x1b, 0x41, 0x02, 0xe8, 0x03, 0x7d, 0x75, 0x30, 0x3c, 0x62, 0xe5,
+	0xcd, 0xbc, 0xd9, 0x0d, 0x1d, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00,
+	0x50, 0x00, 0x02, 0x02, 0x03, 0xfa, 0x19, 0xa1, 0xbd, 0x4c, 0x44, 0x20, 0xbd, 0xe1, 0x56, 0x1d,
+	0x41, 0x02, 0xe8, 0x03, 0xa1, 0x2c, 0x72, 0xbd, 0x65, 0xbf, 0x3f, 0x3d, 0xde, 0xd6, 0x1c, 0x41,
+	0x02, 0xe8, 0x03, 0xd1, 0xb8, 0x1f, 0xbc, 0x65, 0x33, 0x23, 0x3d, 0xff, 0x65, 0x1c, 0x41, 0x01,
+	0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0xee, 0xf7,
+	0xab, 0xbd, 0x24, 0xdd, 0xc6, 0x3c, 0x85, 0xc0, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0xfe, 0xbf, 0xae,
+	0x3c, 0x92, 0x7f, 0xd8, 0x3b, 0x33, 0x34, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x8a, 0xfb, 0x62, 0x3c,
+	0x53, 0xfb, 0xdd, 0x3a, 0xf1, 0xdc, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46,
+	0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x1a, 0xba, 0x0b, 0x3d, 0x29, 0x7d, 0xe4, 0xbc, 0x58,
+	0x91, 0x1b, 0x41, 0x02, 0xe8, 0x03, 0x5a, 0xf8, 0xf8, 0x3c, 0xc5, 0x70, 0x8e, 0x3c, 0x11, 0xac,
+	0x1b, 0x41, 0x02, 0xe8, 0x03, 0x2f, 0xa2, 0xb6, 0xbb, 0xa1, 0x8b, 0x39, 0xbd, 0xc7, 0xe5, 0x1b,
+	0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03,
+	0xca, 0xdc, 0x8b, 0xbc, 0x6b, 0x61, 0xc0, 0x3d, 0x56, 0x28, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x13,
+	0x30, 0x07, 0xbd, 0xd0, 0x02, 0x8a, 0x3d, 0xfd, 0x71, 0x1e, 0x41, 0x02, 0xe8, 0x03, 0xe0, 0x9c,
+	0x34, 0xbd, 0x1c, 0xd0, 0x8f, 0x3d, 0x16, 0x23, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00,
+	0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x4f, 0xb0, 0x07, 0xbd, 0x74, 0xef, 0x87,
+	0xbc, 0xfd, 0x30, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x02, 0x4d, 0x34, 0x3d, 0x3d, 0xdf, 0xf5, 0xbc,
+	0x4f, 0xa8, 0x1b, 0x41, 0x02, 0xe8, 0x03, 0x46, 0xfa, 0xf6, 0xbc, 0x26, 0x27, 0x2b, 0xbd, 0xd5,
+	0x88, 0x1d, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02,
+	0x02, 0x03, 0xd0, 0x0e, 0xb7, 0xbb, 0x07, 0x3e, 0x8b, 0xbb, 0x23, 0x83, 0x1c, 0x41, 0x02, 0xe8,
+	0x03, 0x33, 0x0c, 0x86, 0x3c, 0x6d, 0x88, 0xc1, 0xbc, 0x61, 0xde, 0x1d, 0x41, 0x02, 0xe8, 0x03,
+	0x6d, 0x05, 0x48, 0xbc, 0xe8, 0x0f, 0xf4, 0xbd, 0x97, 0xb7, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00,
+	0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x74, 0x15, 0x93, 0x3d, 0x20,
+	0xcb, 0x22, 0xbd, 0x45, 0x61, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x77, 0x0b, 0xa2, 0xbb, 0xd2, 0xc5,
+	0x17, 0xbb, 0x7b, 0x52, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x26, 0xc9, 0xc5, 0xbb, 0x3b, 0x58, 0xac,
+	0xbd, 0xfc, 0xc3, 0x1b, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50,
+	0x00, 0x02, 0x02, 0x03, 0x4f, 0x26, 0xd4, 0xbc, 0xd5, 0x99, 0x30, 0x3c, 0x68, 0x1f, 0x1d, 0x41,
+	0x02, 0xe8, 0x03, 0xe0, 0x05, 0x37, 0x3d, 0xda, 0x7a, 0x9f, 0xbd, 0xf7, 0xb7, 0x1d, 0x41, 0x02,
+	0xe8, 0x03, 0xda, 0xc1, 0x93, 0xbd, 0x7d, 0x28, 0x4b, 0x3d, 0x4a, 0x60, 0x1d, 0x41, 0x01, 0x00,
+	0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x5b, 0xaf, 0xe5,
+	0xbc, 0xd8, 0x16, 0x20, 0x3d, 0xa7, 0x5d, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0xfc, 0x23, 0xa7, 0x3c,
+	0xcb, 0x03, 0x61, 0x3d, 0xb8, 0x56, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0xfd, 0x8a, 0x15, 0x3d, 0x78,
+	0xcc, 0x15, 0x3d, 0xd5, 0x81, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00,
+	0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x02, 0x0a, 0x87, 0x3d, 0x8f, 0x2a, 0x3d, 0xbc, 0x57, 0xa9,
+	0x1d, 0x41, 0x02, 0xe8, 0x03, 0xc9, 0xfa, 0x00, 0x3c, 0xd7, 0x53, 0x23, 0x3d, 0xbe, 0x9d, 0x1d,
+	0x41, 0x02, 0xe8, 0x03, 0x34, 0x71, 0x00, 0xbc, 0xcf, 0x83, 0x15, 0xbd, 0xf3, 0xcd, 0x1c, 0x41,
+	0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x1a,
+	0x43, 0x87, 0xbd, 0xe0, 0xde, 0x35, 0xbd, 0x6b, 0xbb, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x62, 0xb9,
+	0xde, 0xbc, 0x47, 0x60, 0x16, 0x3c, 0x78, 0x5e, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0xa2, 0x23, 0x82,
+	0x3d, 0x42, 0x14, 0x35, 0x3c, 0x09, 0xfb, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01,
+	0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0xb4, 0x5f, 0x25, 0x3d, 0x89, 0x59, 0x5c, 0xbd,
+	0x6d, 0x40, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x20, 0x6a, 0x43, 0xbc, 0xcf, 0xd0, 0x65, 0x3c, 0xe7,
+	0x7c, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x38, 0x8b, 0x5b, 0x3d, 0xbe, 0xbe, 0xa4, 0x3b, 0xe7, 0xfd,
+	0x1b, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02,
+	0x03, 0xf5, 0xd6, 0x09, 0xbc, 0x2b, 0xe2, 0x9e, 0x3c, 0x8a, 0x9d, 0x1b, 0x41, 0x02, 0xe8, 0x03,
+	0x32, 0x74, 0x93, 0x3c, 0xe9, 0x5f, 0xbc, 0x3d, 0xb5, 0xae, 0x1b, 0x41, 0x02, 0xe8, 0x03, 0xe5,
+	0x11, 0xbb, 0x3d, 0xf7, 0x9e, 0x19, 0xbd, 0x15, 0x3f, 0x1d, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50,
+	0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x37, 0x9c, 0xb5, 0x3a, 0x20, 0xef,
+	0xf0, 0x3d, 0x99, 0xc2, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x12, 0xc8, 0xc1, 0xbd, 0xf9, 0x5b, 0xe3,
+	0xbc, 0x6c, 0xad, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0x1a, 0xf1, 0xad, 0xbd, 0xba, 0x15, 0x69, 0xbd,
+	0x8a, 0x8b, 0x1e, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00,
+	0x02, 0x02, 0x03, 0x82, 0xb0, 0x35, 0xbd, 0xf2, 0x06, 0x25, 0xbd, 0x80, 0xb7, 0x1b, 0x41, 0x02,
+	0xe8, 0x03, 0x87, 0xe0, 0x1d, 0xbd, 0xb1, 0x37, 0x18, 0x3d, 0xdb, 0xbb, 0x1c, 0x41, 0x02, 0xe8,
+	0x03, 0x88, 0xc0, 0x68, 0xbd, 0xdc, 0x44, 0x82, 0x3d, 0xf0, 0xd8, 0x1b, 0x41, 0x01, 0x00, 0x00,
+	0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00, 0x50, 0x00, 0x02, 0x02, 0x03, 0x0a, 0xe8, 0x17, 0xbd,
+	0xa1, 0x7a, 0x7b, 0xbc, 0xea, 0x55, 0x1c, 0x41, 0x02, 0xe8, 0x03, 0x03, 0x07, 0x60, 0xbc, 0x22,
+	0x88, 0x2b, 0x3d, 0x1a, 0x6c, 0x1d, 0x41, 0x02, 0xe8, 0x03, 0xf8, 0x15, 0xac, 0x3c, 0xb9, 0x0e,
+	0x7f, 0xbb, 0xa2, 0xf1, 0x1c, 0x41, 0x01, 0x00, 0x00, 0x00, 0x50, 0x00, 0x01, 0x46, 0x00, 0x00,
+	0x50, 0x00, 0x02, 0x02, 0x03, 0x60, 0x20, 0x0d, 0x3d, 0x8c, 0x00, 0xaf, 0x3b, 0x27, 0x34, 0x1c,
+	0x41,
+};
@@ -1,5 +1,5 @@
 #define SIDEEYE_FRAMES 6
-const unsigned char sideEyes[2][6][1024] PROGMEM = {
+const unsigned char sideEyes[2][6][1024] PROGMEM __attribute__((aligned(4))) = {
   {
 
 	// 'sprite_0, 128x64px
@@ -1,5 +1,5 @@
 #define SLEEP_FRAMES 8
-const unsigned char sleep[8] [1024] PROGMEM = {
+const unsigned char sleep[8] [1024] PROGMEM __attribute__((aligned(4))) = {
 
 	// 'sprite_0, 128x64px
 
@@ -0,0 +1,89 @@
+#include "Adafruit_GFX.h"
+#include "glcdfont.c"
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; i++) {
+    drawPixel(x, y + i, color);
+  }
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; i++) {
+    drawPixel(x + i, y, color);
+  }
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t i = x; i < x + w; i++) {
+    drawFastVLine(i, y, h, color);
+  }
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y, h, color);
+  drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7))) {
+        drawPixel(x + i, y + j, color);
+      }
+    }
+  }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      bool on = pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7));
+      drawPixel(x + i, y + j, on ? color : bg);
+    }
+  }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+  if (x >= _width || y >= _height || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) {
+    return;
+  }
+  if (!_cp437 && c >= 176) {
+    c++;  // the font has a gap at 176 unless cp437() closes it
+  }
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (line & 1) {
+        fillRect(x + i * size, y + j * size, size, size, color);
+      } else if (bg != color) {
+        fillRect(x + i * size, y + j * size, size, size, bg);
+      }
+    }
+  }
+  if (bg != color) {
+    fillRect(x + 5 * size, y, size, 8 * size, bg);
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += textsize * 8;
+  } else if (c != '\r') {
+    if (wrap && cursor_x + textsize * 6 > _width) {
+      cursor_x = 0;
+      cursor_y += textsize * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+    cursor_x += textsize * 6;
+  }
+  return 1;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "Arduino.h"
+
+/**
+   The Adafruit_GFX drawing the firmware relies on, with the same pixel
+   semantics: bitmaps are row-major with the leftmost pixel in the MSB,
+   text is the 5x7 font of glcdfont.c on a 6x8 cell, and everything that is
+   not overridden ends up in drawPixel().
+*/
+
+class Adafruit_GFX : public Print {
+ public:
+  Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color);
+
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+  void setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+  }
+  void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+  void setTextColor(uint16_t c, uint16_t bg) {
+    textcolor = c;
+    textbgcolor = bg;
+  }
+  void setTextSize(uint8_t s) { textsize = s ? s : 1; }
+  void setTextWrap(bool w) { wrap = w; }
+  void cp437(bool x = true) { _cp437 = x; }
+  int16_t getCursorX() const { return cursor_x; }
+  int16_t getCursorY() const { return cursor_y; }
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  uint8_t getRotation() const { return 0; }
+
+ protected:
+  const int16_t WIDTH, HEIGHT;
+  int16_t _width, _height;
+  int16_t cursor_x = 0, cursor_y = 0;
+  uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+  uint8_t textsize = 1;
+  bool wrap = true;
+  bool _cp437 = false;
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+// the two types of the Adafruit unified sensor API the firmware passes around
+
+struct sensors_vec_t {
+  float x, y, z;
+};
+
+struct sensors_event_t {
+  int32_t version;
+  int32_t sensor_id;
+  int32_t type;
+  int32_t timestamp;
+  sensors_vec_t acceleration;
+};
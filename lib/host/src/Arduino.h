@@ -0,0 +1,176 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include "binary.h"
+
+/**
+   The part of the ESP8266 Arduino core the firmware uses, for the native
+   env. Time only moves when a test moves it (host.h), so runs repeat to
+   the microsecond. Flash is ordinary memory, interrupts never preempt and
+   pins read low.
+*/
+
+#ifndef F_CPU
+#define F_CPU 160000000L
+#endif
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (s)
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+#define A0 17
+
+#define digitalPinToInterrupt(pin) (pin)
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+void pinMode(uint8_t pin, uint8_t mode);
+int analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+void interrupts();
+void noInterrupts();
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// the interrupt level and timer1 of the Xtensa core, timer1 ticks at 80 MHz / 256
+uint32_t xt_rsil(uint32_t level);
+void xt_wsr_ps(uint32_t state);
+
+#define TIM_DIV1 0
+#define TIM_DIV16 1
+#define TIM_DIV256 3
+#define TIM_EDGE 0
+#define TIM_LEVEL 1
+#define TIM_SINGLE 0
+#define TIM_LOOP 1
+
+typedef void (*timercallback)(void);
+void timer1_attachInterrupt(timercallback handler);
+void timer1_detachInterrupt();
+void timer1_enable(uint8_t divider, uint8_t intType, uint8_t reload);
+void timer1_disable();
+void timer1_write(uint32_t ticks);
+
+class String : public std::string {
+ public:
+  String() {}
+  String(const char *s) : std::string(s) {}
+  String(const std::string &s) : std::string(s) {}
+  String(char c) : std::string(1, c) {}
+  String(int v) : std::string(std::to_string(v)) {}
+  String(unsigned int v) : std::string(std::to_string(v)) {}
+  String(long v) : std::string(std::to_string(v)) {}
+  String(unsigned long v) : std::string(std::to_string(v)) {}
+  unsigned int length() const { return size(); }
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = 10);
+  size_t print(unsigned long v, int base = 10);
+  size_t print(double v, int digits = 2);
+
+  template <class T>
+  size_t println(T v) {
+    return print(v) + println();
+  }
+  template <class T>
+  size_t println(T v, int format) {
+    return print(v, format) + println();
+  }
+  size_t println() { return write("\r\n"); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/**
+ * Serial keeps what the firmware sends, a test can look at it or drop it
+ */
+class HardwareSerial : public Print {
+ public:
+  void begin(unsigned long) {}
+  int available() { return 0; }
+  int read() { return -1; }
+  int availableForWrite() { return 256; }
+  void flush() {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  std::string sent;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+ public:
+  uint32_t getCycleCount();
+  uint8_t getCpuFreqMHz() { return F_CPU / 1000000L; }
+  uint32_t getFreeHeap() { return 40000; }
+  uint16_t getMaxFreeBlockSize() { return 30000; }
+  uint8_t getHeapFragmentation() { return 0; }
+  void restart() { abort(); }
+};
+
+extern EspClass ESP;
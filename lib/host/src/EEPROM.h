@@ -0,0 +1,35 @@
+#pragma once
+#include "Arduino.h"
+
+/**
+   EEPROM emulation in RAM, it starts out erased and lasts as long as the
+   test binary.
+*/
+
+#define HOST_EEPROM_SIZE 4096
+
+class EEPROMClass {
+ public:
+  void begin(size_t) {}
+  bool commit() { return true; }
+  uint8_t read(int address) { return data[address]; }
+  void write(int address, uint8_t value) { data[address] = value; }
+
+  template <class T>
+  T &get(int address, T &value) {
+    memcpy(&value, data + address, sizeof(T));
+    return value;
+  }
+
+  template <class T>
+  const T &put(int address, const T &value) {
+    memcpy(data + address, &value, sizeof(T));
+    return value;
+  }
+
+  uint8_t data[HOST_EEPROM_SIZE];
+
+  EEPROMClass() { memset(data, 0xFF, sizeof(data)); }
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,33 @@
+#pragma once
+#include "Arduino.h"
+
+/**
+   LittleFS on a directory of the host, set with hostFsRoot() (host.h).
+   Without one nothing opens, like a board without a filesystem image.
+*/
+
+class File : public Print {
+ public:
+  File(FILE *f = nullptr) : f(f) {}
+  explicit operator bool() const { return f; }
+  size_t read(uint8_t *buffer, size_t size) { return f ? fread(buffer, 1, size, f) : 0; }
+  int read() { return f ? fgetc(f) : -1; }
+  bool seek(uint32_t position) { return f && fseek(f, position, SEEK_SET) == 0; }
+  size_t position() { return f ? ftell(f) : 0; }
+  size_t size();
+  void close();
+  size_t write(uint8_t c) override { return f && fputc(c, f) != EOF; }
+  using Print::write;
+
+ private:
+  FILE *f;
+};
+
+class FS {
+ public:
+  bool begin() { return true; }
+  File open(const char *path, const char *mode);
+  bool exists(const char *path);
+};
+
+extern FS LittleFS;
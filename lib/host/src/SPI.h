@@ -0,0 +1,23 @@
+#pragma once
+#include "Arduino.h"
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+struct SPISettings {
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+// nothing is wired to it, the native env uses the mock panel
+class SPIClass {
+ public:
+  void begin() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void writeBytes(const uint8_t *, uint32_t) {}
+  void setFrequency(uint32_t) {}
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,33 @@
+#pragma once
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 128
+
+/**
+   An I2C bus with only the MPU6050 on it, its registers are the array in
+   host.h. A read starts at the register the last write pointed at, any
+   other address does not acknowledge.
+*/
+
+class TwoWire {
+ public:
+  void begin() {}
+  void setClock(uint32_t hz) { clock = hz; }
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t value);
+  size_t write(const uint8_t *bytes, size_t count);
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t count);
+  int available() { return left; }
+  int read();
+
+  uint32_t clock = 100000;
+
+ private:
+  uint8_t address = 0;
+  bool pointed = false;
+  uint8_t reg = 0;
+  uint8_t left = 0;
+};
+
+extern TwoWire Wire;
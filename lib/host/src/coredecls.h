@@ -0,0 +1,12 @@
+#pragma once
+#include <functional>
+#include "Arduino.h"
+
+/**
+   The scheduler hooks of the core. Nothing runs concurrently on the host,
+   esp_delay() moves the clock until the condition is false or the time is
+   up, timer1 firing on the way.
+*/
+
+void esp_schedule();
+void esp_delay(unsigned long ms, std::function<bool()> blocked);
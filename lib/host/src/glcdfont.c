@@ -0,0 +1,269 @@
+#pragma once
+
+/**
+   Stand-in for the 5x7 font of Adafruit GFX, 5 column bytes per glyph, top
+   row in the LSB, the bottom row left empty like the real one. The glyphs
+   are a pattern made from the code and the column, not letters: the tests
+   only compare drawing paths that read the same table with each other.
+   The space is blank. It is only ever #included, by Adafruit_GFX.cpp and
+   flappy.cpp, library.json keeps it out of the build as a file of its own.
+*/
+
+static const unsigned char font[] PROGMEM = {
+  0x00, 0x2B, 0x56, 0x01, 0x2C,
+  0x1E, 0x49, 0x34, 0x7F, 0x4A,
+  0x3C, 0x67, 0x12, 0x5D, 0x68,
+  0x5A, 0x05, 0x70, 0x3B, 0x06,
+  0x78, 0x23, 0x4E, 0x19, 0x24,
+  0x16, 0x41, 0x2C, 0x77, 0x42,
+  0x34, 0x7F, 0x0A, 0x55, 0x60,
+  0x52, 0x1D, 0x68, 0x33, 0x7E,
+  0x71, 0x3A, 0x47, 0x10, 0x1D,
+  0x0F, 0x58, 0x25, 0x0E, 0x3B,
+  0x2D, 0x76, 0x03, 0x6C, 0x59,
+  0x4B, 0x14, 0x61, 0x4A, 0x77,
+  0x69, 0x32, 0x7F, 0x28, 0x15,
+  0x07, 0x50, 0x5D, 0x06, 0x33,
+  0x25, 0x4E, 0x3B, 0x64, 0x51,
+  0x43, 0x6C, 0x19, 0x42, 0x6F,
+  0x62, 0x09, 0x74, 0x23, 0x0E,
+  0x7C, 0x2B, 0x56, 0x1D, 0x28,
+  0x1E, 0x45, 0x30, 0x7F, 0x4A,
+  0x38, 0x67, 0x12, 0x59, 0x64,
+  0x5A, 0x01, 0x6C, 0x3B, 0x06,
+  0x74, 0x23, 0x4E, 0x15, 0x20,
+  0x16, 0x5D, 0x28, 0x77, 0x42,
+  0x30, 0x7F, 0x0A, 0x51, 0x5C,
+  0x53, 0x18, 0x65, 0x32, 0x7F,
+  0x6D, 0x3A, 0x47, 0x2C, 0x19,
+  0x0F, 0x54, 0x21, 0x0E, 0x3B,
+  0x29, 0x76, 0x03, 0x68, 0x55,
+  0x4B, 0x10, 0x1D, 0x4A, 0x77,
+  0x65, 0x32, 0x7F, 0x24, 0x11,
+  0x07, 0x2C, 0x59, 0x06, 0x33,
+  0x21, 0x4E, 0x3B, 0x60, 0x4D,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x5A, 0x0D, 0x70, 0x3B, 0x0E,
+  0x78, 0x23, 0x56, 0x19, 0x2C,
+  0x1E, 0x41, 0x34, 0x7F, 0x42,
+  0x3C, 0x67, 0x0A, 0x5D, 0x60,
+  0x52, 0x05, 0x68, 0x33, 0x06,
+  0x70, 0x3B, 0x4E, 0x11, 0x24,
+  0x16, 0x59, 0x2C, 0x77, 0x3A,
+  0x35, 0x7E, 0x03, 0x54, 0x59,
+  0x4B, 0x1C, 0x61, 0x4A, 0x7F,
+  0x69, 0x32, 0x47, 0x28, 0x1D,
+  0x0F, 0x50, 0x25, 0x0E, 0x33,
+  0x2D, 0x76, 0x3B, 0x6C, 0x51,
+  0x43, 0x14, 0x19, 0x42, 0x77,
+  0x61, 0x0A, 0x7F, 0x20, 0x15,
+  0x07, 0x28, 0x5D, 0x06, 0x2B,
+  0x26, 0x4D, 0x30, 0x67, 0x4A,
+  0x38, 0x6F, 0x12, 0x59, 0x6C,
+  0x5A, 0x01, 0x74, 0x3B, 0x0E,
+  0x7C, 0x23, 0x56, 0x1D, 0x20,
+  0x1E, 0x45, 0x28, 0x7F, 0x42,
+  0x30, 0x67, 0x0A, 0x51, 0x64,
+  0x52, 0x19, 0x6C, 0x33, 0x06,
+  0x74, 0x3B, 0x4E, 0x15, 0x18,
+  0x17, 0x5C, 0x21, 0x76, 0x3B,
+  0x29, 0x7E, 0x03, 0x68, 0x5D,
+  0x4B, 0x10, 0x65, 0x4A, 0x7F,
+  0x6D, 0x32, 0x47, 0x2C, 0x11,
+  0x0F, 0x54, 0x59, 0x0E, 0x33,
+  0x21, 0x76, 0x3B, 0x60, 0x55,
+  0x43, 0x68, 0x1D, 0x42, 0x77,
+  0x65, 0x0A, 0x7F, 0x24, 0x09,
+  0x08, 0x23, 0x5E, 0x09, 0x24,
+  0x16, 0x41, 0x3C, 0x77, 0x42,
+  0x34, 0x6F, 0x1A, 0x55, 0x60,
+  0x52, 0x0D, 0x78, 0x33, 0x0E,
+  0x70, 0x2B, 0x46, 0x11, 0x2C,
+  0x1E, 0x49, 0x24, 0x7F, 0x4A,
+  0x3C, 0x77, 0x02, 0x5D, 0x68,
+  0x5A, 0x15, 0x60, 0x3B, 0x76,
+  0x79, 0x32, 0x4F, 0x18, 0x15,
+  0x07, 0x50, 0x2D, 0x06, 0x33,
+  0x25, 0x7E, 0x0B, 0x64, 0x51,
+  0x43, 0x1C, 0x69, 0x42, 0x7F,
+  0x61, 0x3A, 0x77, 0x20, 0x1D,
+  0x0F, 0x58, 0x55, 0x0E, 0x3B,
+  0x2D, 0x46, 0x33, 0x6C, 0x59,
+  0x4B, 0x64, 0x11, 0x4A, 0x67,
+  0x6A, 0x01, 0x7C, 0x2B, 0x06,
+  0x74, 0x23, 0x5E, 0x15, 0x20,
+  0x16, 0x4D, 0x38, 0x77, 0x42,
+  0x30, 0x6F, 0x1A, 0x51, 0x6C,
+  0x52, 0x09, 0x64, 0x33, 0x0E,
+  0x7C, 0x2B, 0x46, 0x1D, 0x28,
+  0x1E, 0x55, 0x20, 0x7F, 0x4A,
+  0x38, 0x77, 0x02, 0x59, 0x54,
+  0x5B, 0x10, 0x6D, 0x3A, 0x77,
+  0x65, 0x32, 0x4F, 0x24, 0x11,
+  0x07, 0x5C, 0x29, 0x06, 0x33,
+  0x21, 0x7E, 0x0B, 0x60, 0x5D,
+  0x43, 0x18, 0x15, 0x42, 0x7F,
+  0x6D, 0x3A, 0x77, 0x2C, 0x19,
+  0x0F, 0x24, 0x51, 0x0E, 0x3B,
+  0x29, 0x46, 0x33, 0x68, 0x45,
+  0x4C, 0x67, 0x1A, 0x4D, 0x60,
+  0x52, 0x05, 0x78, 0x33, 0x06,
+  0x70, 0x2B, 0x5E, 0x11, 0x24,
+  0x16, 0x49, 0x3C, 0x77, 0x4A,
+  0x34, 0x6F, 0x02, 0x55, 0x68,
+  0x5A, 0x0D, 0x60, 0x3B, 0x0E,
+  0x78, 0x33, 0x46, 0x19, 0x2C,
+  0x1E, 0x51, 0x24, 0x7F, 0x32,
+  0x3D, 0x76, 0x0B, 0x5C, 0x51,
+  0x43, 0x14, 0x69, 0x42, 0x77,
+  0x61, 0x3A, 0x4F, 0x20, 0x15,
+  0x07, 0x58, 0x2D, 0x06, 0x3B,
+  0x25, 0x7E, 0x33, 0x64, 0x59,
+  0x4B, 0x1C, 0x11, 0x4A, 0x7F,
+  0x69, 0x02, 0x77, 0x28, 0x1D,
+  0x0F, 0x20, 0x55, 0x0E, 0x23,
+  0x2E, 0x45, 0x38, 0x6F, 0x42,
+  0x30, 0x67, 0x1A, 0x51, 0x64,
+  0x52, 0x09, 0x7C, 0x33, 0x06,
+  0x74, 0x2B, 0x5E, 0x15, 0x28,
+  0x16, 0x4D, 0x20, 0x77, 0x4A,
+  0x38, 0x6F, 0x02, 0x59, 0x6C,
+  0x5A, 0x11, 0x64, 0x3B, 0x0E,
+  0x7C, 0x33, 0x46, 0x1D, 0x10,
+  0x1F, 0x54, 0x29, 0x7E, 0x33,
+  0x21, 0x76, 0x0B, 0x60, 0x55,
+  0x43, 0x18, 0x6D, 0x42, 0x77,
+  0x65, 0x3A, 0x4F, 0x24, 0x19,
+  0x07, 0x5C, 0x51, 0x06, 0x3B,
+  0x29, 0x7E, 0x33, 0x68, 0x5D,
+  0x4B, 0x60, 0x15, 0x4A, 0x7F,
+  0x6D, 0x02, 0x77, 0x2C, 0x01,
+  0x10, 0x3B, 0x46, 0x11, 0x3C,
+  0x0E, 0x59, 0x24, 0x6F, 0x5A,
+  0x2C, 0x77, 0x02, 0x4D, 0x78,
+  0x4A, 0x15, 0x60, 0x2B, 0x16,
+  0x68, 0x33, 0x5E, 0x09, 0x34,
+  0x06, 0x51, 0x3C, 0x67, 0x52,
+  0x24, 0x6F, 0x1A, 0x45, 0x70,
+  0x42, 0x0D, 0x78, 0x23, 0x6E,
+  0x61, 0x2A, 0x57, 0x00, 0x0D,
+  0x1F, 0x48, 0x35, 0x1E, 0x2B,
+  0x3D, 0x66, 0x13, 0x7C, 0x49,
+  0x5B, 0x04, 0x71, 0x5A, 0x67,
+  0x79, 0x22, 0x6F, 0x38, 0x05,
+  0x17, 0x40, 0x4D, 0x16, 0x23,
+  0x35, 0x5E, 0x2B, 0x74, 0x41,
+  0x53, 0x7C, 0x09, 0x52, 0x7F,
+  0x72, 0x19, 0x64, 0x33, 0x1E,
+  0x6C, 0x3B, 0x46, 0x0D, 0x38,
+  0x0E, 0x55, 0x20, 0x6F, 0x5A,
+  0x28, 0x77, 0x02, 0x49, 0x74,
+  0x4A, 0x11, 0x7C, 0x2B, 0x16,
+  0x64, 0x33, 0x5E, 0x05, 0x30,
+  0x06, 0x4D, 0x38, 0x67, 0x52,
+  0x20, 0x6F, 0x1A, 0x41, 0x4C,
+  0x43, 0x08, 0x75, 0x22, 0x6F,
+  0x7D, 0x2A, 0x57, 0x3C, 0x09,
+  0x1F, 0x44, 0x31, 0x1E, 0x2B,
+  0x39, 0x66, 0x13, 0x78, 0x45,
+  0x5B, 0x00, 0x0D, 0x5A, 0x67,
+  0x75, 0x22, 0x6F, 0x34, 0x01,
+  0x17, 0x3C, 0x49, 0x16, 0x23,
+  0x31, 0x5E, 0x2B, 0x70, 0x5D,
+  0x54, 0x7F, 0x02, 0x55, 0x78,
+  0x4A, 0x1D, 0x60, 0x2B, 0x1E,
+  0x68, 0x33, 0x46, 0x09, 0x3C,
+  0x0E, 0x51, 0x24, 0x6F, 0x52,
+  0x2C, 0x77, 0x1A, 0x4D, 0x70,
+  0x42, 0x15, 0x78, 0x23, 0x16,
+  0x60, 0x2B, 0x5E, 0x01, 0x34,
+  0x06, 0x49, 0x3C, 0x67, 0x2A,
+  0x25, 0x6E, 0x13, 0x44, 0x49,
+  0x5B, 0x0C, 0x71, 0x5A, 0x6F,
+  0x79, 0x22, 0x57, 0x38, 0x0D,
+  0x1F, 0x40, 0x35, 0x1E, 0x23,
+  0x3D, 0x66, 0x2B, 0x7C, 0x41,
+  0x53, 0x04, 0x09, 0x52, 0x67,
+  0x71, 0x1A, 0x6F, 0x30, 0x05,
+  0x17, 0x38, 0x4D, 0x16, 0x3B,
+  0x36, 0x5D, 0x20, 0x77, 0x5A,
+  0x28, 0x7F, 0x02, 0x49, 0x7C,
+  0x4A, 0x11, 0x64, 0x2B, 0x1E,
+  0x6C, 0x33, 0x46, 0x0D, 0x30,
+  0x0E, 0x55, 0x38, 0x6F, 0x52,
+  0x20, 0x77, 0x1A, 0x41, 0x74,
+  0x42, 0x09, 0x7C, 0x23, 0x16,
+  0x64, 0x2B, 0x5E, 0x05, 0x08,
+  0x07, 0x4C, 0x31, 0x66, 0x2B,
+  0x39, 0x6E, 0x13, 0x78, 0x4D,
+  0x5B, 0x00, 0x75, 0x5A, 0x6F,
+  0x7D, 0x22, 0x57, 0x3C, 0x01,
+  0x1F, 0x44, 0x49, 0x1E, 0x23,
+  0x31, 0x66, 0x2B, 0x70, 0x45,
+  0x53, 0x78, 0x0D, 0x52, 0x67,
+  0x75, 0x1A, 0x6F, 0x34, 0x19,
+  0x18, 0x33, 0x4E, 0x19, 0x34,
+  0x06, 0x51, 0x2C, 0x67, 0x52,
+  0x24, 0x7F, 0x0A, 0x45, 0x70,
+  0x42, 0x1D, 0x68, 0x23, 0x1E,
+  0x60, 0x3B, 0x56, 0x01, 0x3C,
+  0x0E, 0x59, 0x34, 0x6F, 0x5A,
+  0x2C, 0x67, 0x12, 0x4D, 0x78,
+  0x4A, 0x05, 0x70, 0x2B, 0x66,
+  0x69, 0x22, 0x5F, 0x08, 0x05,
+  0x17, 0x40, 0x3D, 0x16, 0x23,
+  0x35, 0x6E, 0x1B, 0x74, 0x41,
+  0x53, 0x0C, 0x79, 0x52, 0x6F,
+  0x71, 0x2A, 0x67, 0x30, 0x0D,
+  0x1F, 0x48, 0x45, 0x1E, 0x2B,
+  0x3D, 0x56, 0x23, 0x7C, 0x49,
+  0x5B, 0x74, 0x01, 0x5A, 0x77,
+  0x7A, 0x11, 0x6C, 0x3B, 0x16,
+  0x64, 0x33, 0x4E, 0x05, 0x30,
+  0x06, 0x5D, 0x28, 0x67, 0x52,
+  0x20, 0x7F, 0x0A, 0x41, 0x7C,
+  0x42, 0x19, 0x74, 0x23, 0x1E,
+  0x6C, 0x3B, 0x56, 0x0D, 0x38,
+  0x0E, 0x45, 0x30, 0x6F, 0x5A,
+  0x28, 0x67, 0x12, 0x49, 0x44,
+  0x4B, 0x00, 0x7D, 0x2A, 0x67,
+  0x75, 0x22, 0x5F, 0x34, 0x01,
+  0x17, 0x4C, 0x39, 0x16, 0x23,
+  0x31, 0x6E, 0x1B, 0x70, 0x4D,
+  0x53, 0x08, 0x05, 0x52, 0x6F,
+  0x7D, 0x2A, 0x67, 0x3C, 0x09,
+  0x1F, 0x34, 0x41, 0x1E, 0x2B,
+  0x39, 0x56, 0x23, 0x78, 0x55,
+  0x5C, 0x77, 0x0A, 0x5D, 0x70,
+  0x42, 0x15, 0x68, 0x23, 0x16,
+  0x60, 0x3B, 0x4E, 0x01, 0x34,
+  0x06, 0x59, 0x2C, 0x67, 0x5A,
+  0x24, 0x7F, 0x12, 0x45, 0x78,
+  0x4A, 0x1D, 0x70, 0x2B, 0x1E,
+  0x68, 0x23, 0x56, 0x09, 0x3C,
+  0x0E, 0x41, 0x34, 0x6F, 0x22,
+  0x2D, 0x66, 0x1B, 0x4C, 0x41,
+  0x53, 0x04, 0x79, 0x52, 0x67,
+  0x71, 0x2A, 0x5F, 0x30, 0x05,
+  0x17, 0x48, 0x3D, 0x16, 0x2B,
+  0x35, 0x6E, 0x23, 0x74, 0x49,
+  0x5B, 0x0C, 0x01, 0x5A, 0x6F,
+  0x79, 0x12, 0x67, 0x38, 0x0D,
+  0x1F, 0x30, 0x45, 0x1E, 0x33,
+  0x3E, 0x55, 0x28, 0x7F, 0x52,
+  0x20, 0x77, 0x0A, 0x41, 0x74,
+  0x42, 0x19, 0x6C, 0x23, 0x16,
+  0x64, 0x3B, 0x4E, 0x05, 0x38,
+  0x06, 0x5D, 0x30, 0x67, 0x5A,
+  0x28, 0x7F, 0x12, 0x49, 0x7C,
+  0x4A, 0x01, 0x74, 0x2B, 0x1E,
+  0x6C, 0x23, 0x56, 0x0D, 0x00,
+  0x0F, 0x44, 0x39, 0x6E, 0x23,
+  0x31, 0x66, 0x1B, 0x70, 0x45,
+  0x53, 0x08, 0x7D, 0x52, 0x67,
+  0x75, 0x2A, 0x5F, 0x34, 0x09,
+  0x17, 0x4C, 0x41, 0x16, 0x2B,
+  0x39, 0x6E, 0x23, 0x78, 0x4D,
+  0x5B, 0x70, 0x05, 0x5A, 0x6F,
+  0x7D, 0x12, 0x67, 0x3C, 0x11,
+};
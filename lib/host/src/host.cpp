@@ -0,0 +1,279 @@
+#include "host.h"
+#include <coredecls.h>
+#include <EEPROM.h>
+#include <LittleFS.h>
+#include <SPI.h>
+#include <Wire.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+SPIClass SPI;
+TwoWire Wire;
+FS LittleFS;
+EEPROMClass EEPROM;
+
+uint8_t hostMpu[128];
+
+static uint64_t now;  // us
+static timercallback timerHandler;
+static bool timerArmed = false;
+static uint64_t timerDue;
+static uint32_t randomState = 1;
+static const char *fsRoot;
+static bool mpuOnline = true;
+
+void hostAdvance(uint32_t us) {
+  uint64_t until = now + us;
+  while (timerArmed && timerDue <= until) {
+    now = timerDue;
+    timerArmed = false;
+    if (timerHandler) {
+      timerHandler();
+    }
+  }
+  now = until;
+}
+
+void hostAccel(int16_t x, int16_t y, int16_t z) {
+  int16_t v[3] = { x, y, z };
+  for (uint8_t i = 0; i < 3; i++) {
+    hostMpu[0x3B + 2 * i] = (uint16_t)v[i] >> 8;
+    hostMpu[0x3B + 2 * i + 1] = v[i];
+  }
+}
+
+void hostMpuOnline(bool on) {
+  mpuOnline = on;
+}
+
+void hostFsRoot(const char *dir) {
+  fsRoot = dir;
+}
+
+unsigned long millis() {
+  return now / 1000;
+}
+
+unsigned long micros() {
+  return now;
+}
+
+void delay(unsigned long ms) {
+  hostAdvance(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  hostAdvance(us);
+}
+
+void yield() {}
+
+int digitalRead(uint8_t) {
+  return LOW;
+}
+
+void digitalWrite(uint8_t, uint8_t) {}
+void pinMode(uint8_t, uint8_t) {}
+
+int analogRead(uint8_t) {
+  return 0;
+}
+
+void attachInterrupt(uint8_t, void (*)(), int) {}
+void detachInterrupt(uint8_t) {}
+void interrupts() {}
+void noInterrupts() {}
+
+// the same generator on every host, so seeded runs repeat everywhere
+static uint32_t nextRandom() {
+  randomState = randomState * 1103515245 + 12345;
+  return randomState >> 1;
+}
+
+long random(long howBig) {
+  return howBig > 0 ? nextRandom() % howBig : 0;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed) {
+    randomState = seed;  // 0 leaves the generator alone, as on the ESP8266
+  }
+}
+
+uint32_t xt_rsil(uint32_t) {
+  return 0;
+}
+
+void xt_wsr_ps(uint32_t) {}
+
+void timer1_attachInterrupt(timercallback handler) {
+  timerHandler = handler;
+}
+
+void timer1_detachInterrupt() {
+  timerHandler = nullptr;
+}
+
+void timer1_enable(uint8_t, uint8_t, uint8_t) {}
+
+void timer1_disable() {
+  timerArmed = false;
+}
+
+void timer1_write(uint32_t ticks) {
+  timerDue = now + (uint64_t)ticks * 256 / 80;
+  timerArmed = true;
+}
+
+void esp_schedule() {}
+
+void esp_delay(unsigned long ms, std::function<bool()> blocked) {
+  uint64_t until = now + ms * 1000;
+  while (blocked() && now < until) {
+    hostAdvance(timerArmed && timerDue < until ? timerDue - now : until - now);
+  }
+}
+
+uint32_t EspClass::getCycleCount() {
+  return now * (F_CPU / 1000000L);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::print(long v, int base) {
+  if (base == 10) {
+    return print(std::to_string(v).c_str());
+  }
+  return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char digits[8 * sizeof(v) + 1];
+  char *p = digits + sizeof(digits) - 1;
+  *p = 0;
+  do {
+    uint8_t d = v % base;
+    *--p = d < 10 ? '0' + d : 'A' + d - 10;
+    v /= base;
+  } while (v);
+  return print(p);
+}
+
+size_t Print::print(double v, int digits) {
+  char s[32];
+  snprintf(s, sizeof(s), "%.*f", digits, v);
+  return print(s);
+}
+
+size_t Print::printf(const char *format, ...) {
+  char s[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(s, sizeof(s), format, args);
+  va_end(args);
+  return write((const uint8_t *)s, n < (int)sizeof(s) ? n : sizeof(s) - 1);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  sent.push_back(c);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  sent.append((const char *)buffer, size);
+  return size;
+}
+
+void TwoWire::beginTransmission(uint8_t to) {
+  address = to;
+  pointed = false;
+}
+
+static bool mpuAnswers(uint8_t address) {
+  return address == HOST_MPU_ADDRESS && mpuOnline;
+}
+
+size_t TwoWire::write(uint8_t value) {
+  if (mpuAnswers(address) && !pointed) {
+    reg = value & 0x7F;
+    pointed = true;
+  } else if (mpuAnswers(address)) {
+    hostMpu[reg] = value;
+    reg = (reg + 1) & 0x7F;
+  }
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *bytes, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    write(bytes[i]);
+  }
+  return count;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  return mpuAnswers(address) ? 0 : 2;  // 2 is no acknowledge of the address
+}
+
+uint8_t TwoWire::requestFrom(uint8_t from, uint8_t count) {
+  address = from;
+  left = mpuAnswers(from) ? count : 0;
+  return left;
+}
+
+int TwoWire::read() {
+  if (!left) {
+    return -1;
+  }
+  left--;
+  uint8_t value = hostMpu[reg];
+  reg = (reg + 1) & 0x7F;
+  return value;
+}
+
+size_t File::size() {
+  if (!f) {
+    return 0;
+  }
+  long at = ftell(f);
+  fseek(f, 0, SEEK_END);
+  long end = ftell(f);
+  fseek(f, at, SEEK_SET);
+  return end;
+}
+
+void File::close() {
+  if (f) {
+    fclose(f);
+    f = nullptr;
+  }
+}
+
+static std::string hostPath(const char *path) {
+  return std::string(fsRoot) + path;
+}
+
+File FS::open(const char *path, const char *mode) {
+  if (!fsRoot) {
+    return File();
+  }
+  std::string m = std::string(mode) + "b";
+  return File(fopen(hostPath(path).c_str(), m.c_str()));
+}
+
+bool FS::exists(const char *path) {
+  File f = open(path, "r");
+  bool found = (bool)f;
+  f.close();
+  return found;
+}
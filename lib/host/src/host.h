@@ -0,0 +1,19 @@
+#pragma once
+#include "Arduino.h"
+
+/**
+   What a test controls of the host build. The clock starts at zero and only
+   moves through hostAdvance(), delay() and esp_delay(); timer1 fires on the
+   way when it is due. The MPU6050 answers with the registers in hostMpu,
+   hostAccel() sets its accelerometer in raw counts, hostMpuOnline(false)
+   takes it off the bus.
+*/
+
+#define HOST_MPU_ADDRESS 0x68
+
+extern uint8_t hostMpu[128];
+
+void hostAdvance(uint32_t us);
+void hostAccel(int16_t x, int16_t y, int16_t z);
+void hostMpuOnline(bool on);
+void hostFsRoot(const char *dir);
@@ -0,0 +1,139 @@
+#include "anim.h"
+#include <coredecls.h>
+#include "telemetry.h"
+#include "histogram.h"
+
+#define MS_TO_TIMER_TICKS(ms) ((ms) * 3125 / 10)  // timer1 runs at 80 MHz / 256
+
+uint32_t framesDropped = 0;
+
+static unsigned long frameStart;  // when the current frame was due
+static unsigned long frameDue;    // when the next frame is due
+static uint16_t lastPeriod = 0;   // pause after the previous frame
+static uint16_t period = 0;       // pause after the current frame
+
+static volatile bool frameReady = true;
+static volatile uint32_t tickMicros;
+static bool ticked = false;  // the pending frame waits for the timer
+static Histogram jitter;
+
+static void IRAM_ATTR frameTick() {
+  tickMicros = micros();
+  frameReady = true;
+  esp_schedule();  // wakes loop() out of animIdle()
+}
+
+void animBegin() {
+  timer1_attachInterrupt(frameTick);
+}
+
+/**
+ * raises the ready flag when the next frame is due
+ */
+static void arm() {
+  timer1_disable();
+  long wait = frameDue - millis();
+  if (wait <= 0) {
+    frameReady = true;
+    ticked = false;
+    return;
+  }
+  frameReady = false;
+  ticked = true;
+  timer1_enable(TIM_DIV256, TIM_EDGE, TIM_SINGLE);
+  timer1_write(MS_TO_TIMER_TICKS(wait));
+}
+
+/**
+ * draw the next frame right away and schedule from now on, used on mode changes
+ */
+void animReset() {
+  timer1_disable();
+  frameStart = millis();
+  frameDue = frameStart;
+  lastPeriod = 0;
+  period = 0;
+  frameReady = true;
+  ticked = false;
+}
+
+bool animDue() {
+  return frameReady;
+}
+
+/**
+ * a new frame starts rendering, it belongs to the slot it was due in.
+ * unless it holds, the one after it is due right away. after a frame that
+ * did not hold the slot is now, a hold that follows runs its full length
+ */
+void animBeginFrame() {
+  if (ticked) {
+    histogramRecord(jitter, micros() - tickMicros);
+    ticked = false;
+  }
+  if (!period) {
+    frameDue = millis();
+  }
+  frameStart = frameDue;
+  lastPeriod = period;
+  period = 0;
+}
+
+/**
+ * how many whole frame periods the render path is behind
+ */
+uint8_t animLateFrames() {
+  if (!lastPeriod) {
+    return 0;
+  }
+  return min((millis() - frameStart) / lastPeriod, 255UL);
+}
+
+/**
+ * the caller skipped frames, move the schedule along with it. if it could not
+ * skip enough the schedule restarts from now rather than rushing to catch up
+ */
+void animDropped(uint8_t frames) {
+  if (frames) {
+    framesDropped += frames;
+    frameStart += (unsigned long)frames * lastPeriod;
+    telemetryLog(LOG_FRAMES_DROPPED, frames);
+  }
+  if (animLateFrames()) {
+    frameStart = millis();
+  }
+  frameDue = frameStart;
+}
+
+/**
+ * next frame is due ms after this one was due, the last call in a frame wins
+ */
+void animHold(uint16_t ms) {
+  period = ms;
+  frameDue = frameStart + ms;
+  arm();
+}
+
+uint16_t animPeriod() {
+  return period;
+}
+
+/**
+ * lets the CPU idle until the frame tick, for at most ANIM_IDLE_MAX
+ */
+void animIdle() {
+  if (!frameReady) {
+    esp_delay(ANIM_IDLE_MAX, []() { return !frameReady; });
+  }
+}
+
+void animJitterDump(Print &out) {
+  out.print("frames dropped ");
+  out.println(framesDropped);
+  histogramPrint(out, "tick to render", jitter);
+}
+
+void animJitterReset() {
+  histogramReset(jitter);
+  framesDropped = 0;
+}
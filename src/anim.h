@@ -0,0 +1,30 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Animation clock. Every frame is due a fixed time after the previous frame was
+   due, not after it happened to be drawn, so a slow flush or an I2C stall does
+   not stretch the animation. When the render path falls a whole frame period
+   or more behind, the caller skips frames and reports them with animDropped().
+
+   The due time is armed on hardware timer1, its interrupt only raises a ready
+   flag, so loop() can idle in animIdle() instead of comparing millis(). The
+   delay between the tick and the start of the render is kept as jitter
+   statistics, 'j' over Serial dumps them.
+*/
+
+#define ANIM_IDLE_MAX 5  // ms loop() may idle at once, keeps button and MPU polling responsive
+
+extern uint32_t framesDropped;
+
+void animBegin();
+void animReset();
+bool animDue();
+void animBeginFrame();
+uint8_t animLateFrames();
+void animDropped(uint8_t frames);
+void animHold(uint16_t ms);
+uint16_t animPeriod();
+void animIdle();
+void animJitterDump(Print &out);
+void animJitterReset();
@@ -0,0 +1,18 @@
+#include "arena.h"
+
+uint8_t arena[ARENA_SIZE] __attribute__((aligned(4)));
+volatile ArenaOwner arenaOwner = ARENA_EMPTY;
+void (*arenaDestroy)(void *state) = nullptr;
+
+/**
+ * destroys whatever state is in the arena, the owner is dropped first so an
+ * interrupt never sees a half destroyed state
+ */
+void arenaLeave() {
+  if (arenaOwner == ARENA_EMPTY) {
+    return;
+  }
+  arenaOwner = ARENA_EMPTY;
+  arenaDestroy(arena);
+  arenaDestroy = nullptr;
+}
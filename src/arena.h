@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+#include <new>
+
+/**
+   One block of RAM for the working state of the modes that have their own.
+
+   A mode keeps its state in a struct that is placement-constructed in the
+   arena when the mode is entered, arenaEnter() from applyModeSettings(), and
+   destroyed when a mode that does not own it takes over. So the game's
+   walls and scores only take RAM while the game runs, and every mode that
+   comes along later shares the same ARENA_SIZE bytes instead of adding its
+   own globals.
+
+   A state that does not fit fails the build. ARENA_REPORT() also records its
+   size in the ELF, tools/arena_report.py lists them after every link with
+   the peak against ARENA_SIZE.
+*/
+
+#define ARENA_SIZE 64  // bytes, the biggest state so far is the game at 52
+
+enum ArenaOwner : uint8_t {
+  ARENA_EMPTY,
+  ARENA_FLAPPY,
+  ARENA_EYES,
+};
+
+extern uint8_t arena[ARENA_SIZE];
+extern volatile ArenaOwner arenaOwner;
+extern void (*arenaDestroy)(void *state);
+
+void arenaLeave();
+
+/**
+ * the owner's state, constructed first unless it already holds the arena
+ */
+template <class T>
+T *arenaEnter(ArenaOwner owner) {
+  static_assert(sizeof(T) <= ARENA_SIZE, "mode state does not fit the arena");
+  static_assert(alignof(T) <= 4, "the arena is only word aligned");
+  if (arenaOwner != owner) {
+    arenaLeave();
+    new (arena) T();
+    arenaDestroy = [](void *state) { static_cast<T *>(state)->~T(); };
+    arenaOwner = owner;
+  }
+  return reinterpret_cast<T *>(arena);
+}
+
+/**
+ * the owner's state, nullptr while another mode holds the arena. Always
+ * inlined, interrupt handlers use it
+ */
+template <class T>
+inline __attribute__((always_inline)) T *arenaState(ArenaOwner owner) {
+  return arenaOwner == owner ? reinterpret_cast<T *>(arena) : nullptr;
+}
+
+// an absolute symbol arena_<name> holding the size of the state, it takes no RAM or flash
+#define ARENA_REPORT(name, Type) \
+  void arenaReport_##name() { asm(".globl arena_" #name "\n.set arena_" #name ", %c0" ::"i"(sizeof(Type))); }
@@ -0,0 +1,308 @@
+#include "assets.h"
+#include <LittleFS.h>
+#include "framebuffer.h"
+#include "telemetry.h"
+#include "blit.h"
+#include "render.h"
+#include "sleep.h"
+#include "blink.h"
+#include "pet.h"
+#include "maotek.h"
+#include "dizzy.h"
+#include "sideeyes.h"
+#include "study.h"
+#include "memes.h"
+
+// The frame headers come from tools/gen_assets.py for the panel of the env
+static_assert(sizeof(maotek) == SCREEN_WIDTH * SCREEN_PAGES, "frame headers are for another panel size");
+
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+#define READ_CHUNK 64  // compressed bytes read from flash at a time
+
+// names in the pack, make_pack.py takes them from the arrays in include/
+static const char *const clipNames[CLIP_COUNT] = {
+  "blink", "sideEyes0", "sideEyes1", "petting", "dizzy", "sleep", "study", "maotek", "memes",
+};
+static const byte builtinFrames[CLIP_COUNT] = {
+  BLINK_FRAMES, SIDEEYE_FRAMES, SIDEEYE_FRAMES, PET_FRAMES, DIZZY_FRAMES, SLEEP_FRAMES, STUDY_FRAMES, 1, MEMESLEN,
+};
+
+static File pack;
+static byte packFrames[CLIP_COUNT];  // 0 when the clip is not in the pack
+static uint32_t packTables[CLIP_COUNT];
+
+struct CachedFrame {
+  uint8_t clip;  // CLIP_COUNT when empty
+  uint8_t frame;
+  uint8_t data[FRAME_BYTES];
+};
+static CachedFrame *cache;  // ASSET_CACHE_SLOTS on the heap, only with a pack
+static uint8_t lastClip = CLIP_COUNT;
+static uint8_t lastFrame;
+
+static uint32_t hits, misses, loads, loadMicros, loadMax;
+
+static bool streaming = false;
+static const uint8_t *streamFrom;  // what assetsFlush() sends, nullptr for the framebuffer
+static bool streamCached;          // streamFrom is a page-major cache slot, not a row-major bitmap in flash
+static uint8_t shownClip, shownFrame;  // the streamed frame on the panel
+static bool bufferStale = false;   // the framebuffer does not hold it
+
+static uint32_t readU32() {
+  uint8_t b[4];
+  pack.read(b, 4);
+  return b[0] | b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+/**
+ * opens the pack and takes the clips it has, anything that does not fit the
+ * firmware is ignored and keeps the built-in frames
+ */
+void assetsBegin() {
+  if (!LittleFS.begin() || !(pack = LittleFS.open(ASSET_PACK_PATH, "r"))) {
+    return;
+  }
+
+  uint8_t header[8];
+  if (pack.read(header, sizeof(header)) != sizeof(header) || memcmp(header, "MPAK", 4) ||
+      header[4] != ASSET_PACK_VERSION || header[5] != SCREEN_WIDTH || header[6] != SCREEN_HEIGHT) {
+    pack.close();
+    telemetryLog(LOG_ASSETS, -1);
+    return;
+  }
+
+  int32_t taken = 0;
+  for (uint8_t i = 0; i < header[7]; i++) {
+    char name[ASSET_NAME_LENGTH + 1] = {};
+    uint8_t frames[2];
+    pack.read((uint8_t *)name, ASSET_NAME_LENGTH);
+    pack.read(frames, 2);
+    uint16_t count = frames[0] | frames[1] << 8;
+    uint32_t table = readU32();
+
+    for (uint8_t c = 0; c < CLIP_COUNT; c++) {
+      if (strcmp(name, clipNames[c])) {
+        continue;
+      }
+      // the modes time their pauses on fixed frames of the face clips
+      if (count && count <= 255 && (c == CLIP_MEMES || count == builtinFrames[c])) {
+        packFrames[c] = count;
+        packTables[c] = table;
+        taken++;
+      }
+    }
+  }
+
+  // only clips from the pack use the cache, without them its 2 KB stay free
+  if (taken) {
+    cache = (CachedFrame *)malloc(ASSET_CACHE_SLOTS * sizeof(CachedFrame));
+    if (!cache) {
+      memset(packFrames, 0, sizeof(packFrames));
+      pack.close();
+      telemetryLog(LOG_ASSETS, -1);
+      return;
+    }
+    for (uint8_t i = 0; i < ASSET_CACHE_SLOTS; i++) {
+      cache[i].clip = CLIP_COUNT;
+    }
+  }
+  telemetryLog(LOG_ASSETS, taken);
+}
+
+byte assetFrames(AssetClip clip) {
+  return packFrames[clip] ? packFrames[clip] : builtinFrames[clip];
+}
+
+/**
+ * streams one PackBits frame out of the pack: a control byte n < 128 copies
+ * the next n + 1 bytes, n >= 128 repeats the next byte n - 126 times
+ */
+static bool loadFrame(uint8_t clip, uint8_t frame, uint8_t *out) {
+  unsigned long start = micros();
+  if (!pack.seek(packTables[clip] + 4 * frame)) {
+    return false;
+  }
+  uint32_t from = readU32();
+  uint32_t length = readU32() - from;
+  if (!pack.seek(from)) {
+    return false;
+  }
+
+  uint8_t chunk[READ_CHUNK];
+  uint8_t have = 0, at = 0;
+  uint16_t written = 0;
+  int16_t copy = 0;    // literal bytes still to copy
+  int16_t repeat = 0;  // repeats of the next byte
+  while (written < FRAME_BYTES) {
+    if (at == have) {
+      if (!length) {
+        return false;
+      }
+      have = pack.read(chunk, length < READ_CHUNK ? length : READ_CHUNK);
+      if (!have) {
+        return false;
+      }
+      length -= have;
+      at = 0;
+    }
+    uint8_t b = chunk[at++];
+
+    if (copy) {
+      out[written++] = b;
+      copy--;
+    } else if (repeat) {
+      if (written + repeat > FRAME_BYTES) {
+        return false;
+      }
+      memset(out + written, b, repeat);
+      written += repeat;
+      repeat = 0;
+    } else if (b < 128) {
+      copy = b + 1;
+    } else {
+      repeat = b - 126;
+    }
+  }
+
+  uint32_t took = micros() - start;
+  loads++;
+  loadMicros += took;
+  loadMax = max(loadMax, took);
+  return true;
+}
+
+/**
+ * the built-in frame, a full-screen row-major bitmap in flash
+ */
+const uint8_t *assetBitmap(AssetClip clip, byte frame) {
+  switch (clip) {
+    case CLIP_BLINK: return blink[frame];
+    case CLIP_SIDEEYE_0: return sideEyes[0][frame];
+    case CLIP_SIDEEYE_1: return sideEyes[1][frame];
+    case CLIP_PETTING: return petting[frame];
+    case CLIP_DIZZY: return dizzy[frame];
+    case CLIP_SLEEP: return sleep[frame];
+    case CLIP_STUDY: return study[frame];
+    case CLIP_SPLASH: return maotek;
+    default: return memes[frame % MEMESLEN];
+  }
+}
+
+static void streamFrame(uint8_t clip, uint8_t frame, const uint8_t *from, bool cached) {
+  streamFrom = from;
+  streamCached = cached;
+  shownClip = clip;
+  shownFrame = frame;
+}
+
+/**
+ * draws a frame onto the cleared framebuffer, from the cache, the pack or
+ * the firmware in that order. While streaming it only picks the frame for
+ * assetsFlush(), unless it has to be decoded
+ */
+void assetDraw(AssetClip clip, byte frame) {
+  if (!packFrames[clip]) {
+    lastClip = CLIP_COUNT;  // nothing to read ahead
+    const uint8_t *bitmap = assetBitmap(clip, frame);
+    if (streaming) {
+      if (!((uintptr_t)bitmap & 3)) {
+        streamFrame(clip, frame, bitmap, false);
+        return;
+      }
+      display.clearDisplay();
+    }
+    blitFrame(bitmap);
+    return;
+  }
+  lastClip = clip;
+  lastFrame = frame;
+
+  for (uint8_t i = 0; i < ASSET_CACHE_SLOTS; i++) {
+    if (cache[i].clip == clip && cache[i].frame == frame) {
+      hits++;
+      if (streaming) {
+        streamFrame(clip, frame, cache[i].data, true);
+      } else {
+        memcpy(display.getBuffer(), cache[i].data, FRAME_BYTES);
+      }
+      return;
+    }
+  }
+  misses++;
+  if (!loadFrame(clip, frame, display.getBuffer())) {
+    // a broken frame in the pack, show what the firmware has instead
+    display.clearDisplay();
+    blitFrame(assetBitmap(clip, frame % builtinFrames[clip]));
+  }
+}
+
+/**
+ * while on, assetDraw() leaves the framebuffer alone and assetsFlush()
+ * sends the frame straight to the panel. Turning it off puts the frame on
+ * the panel back into the framebuffer, for whatever composes on it next
+ */
+void assetsStream(bool on) {
+  streaming = false;
+  if (!on && bufferStale) {
+    display.clearDisplay();
+    assetDraw((AssetClip)shownClip, shownFrame);
+    bufferStale = false;
+  }
+  streaming = on;
+}
+
+static const uint8_t *cachedPage(uint8_t page, uint8_t *) {
+  return streamFrom + page * SCREEN_WIDTH;
+}
+
+static const uint8_t *flashPage(uint8_t page, uint8_t *row) {
+  memset(row, 0, SCREEN_WIDTH);
+  blitPage(streamFrom, page, row);
+  return row;
+}
+
+/**
+ * sends the frame assetDraw() picked, straight from flash or the cache
+ * while streaming, otherwise from the framebuffer
+ */
+void assetsFlush() {
+  if (!streamFrom) {
+    flushDisplay();
+    bufferStale = false;
+    return;
+  }
+  flushStream(streamCached ? cachedPage : flashPage);
+  streamFrom = nullptr;
+  bufferStale = true;
+}
+
+/**
+ * decodes the frame after the one on the panel into a cache slot the
+ * current frame does not use
+ */
+void assetsPrefetch() {
+  if (lastClip == CLIP_COUNT) {
+    return;
+  }
+  uint8_t next = (lastFrame + 1) % packFrames[lastClip];
+  uint8_t slot = 0;
+  for (uint8_t i = 0; i < ASSET_CACHE_SLOTS; i++) {
+    if (cache[i].clip == lastClip && cache[i].frame == next) {
+      return;
+    }
+    if (cache[i].clip != lastClip || cache[i].frame != lastFrame) {
+      slot = i;
+    }
+  }
+
+  cache[slot].clip = loadFrame(lastClip, next, cache[slot].data) ? lastClip : (uint8_t)CLIP_COUNT;
+  cache[slot].frame = next;
+}
+
+void assetsDump(Print &out) {
+  out.println(pack ? F("asset pack " ASSET_PACK_PATH) : F("no asset pack"));
+  for (uint8_t c = 0; c < CLIP_COUNT; c++) {
+    out.printf("%-10s %3u frames from %s\n", clipNames[c], assetFrames((AssetClip)c), packFrames[c] ? "pack" : "firmware");
+  }
+  out.printf("cache hits %u misses %u, %u loads avg %uus max %uus\n", hits, misses, loads, loads ? loadMicros / loads : 0, loadMax);
+}
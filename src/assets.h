@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Animation frames. The clips built into the firmware (the headers in
+   include/) are always there, an asset pack on LittleFS can replace any of
+   them by name and lets the memes grow past what fits in the sketch. Art
+   updates are then an uploadfs away instead of a reflash: build the pack
+   with tools/make_pack.py into data/ and run `pio run -t uploadfs`.
+
+   Pack layout, little endian:
+     "MPAK", u8 version, u8 width, u8 height, u8 clip count
+     per clip: char name[12], u16 frames, u32 offset of its frame table
+     frame table: frames + 1 u32 offsets, frame i is [offset i, offset i + 1)
+     frame: page-major like the framebuffer, PackBits compressed
+
+   Frames are decoded straight from the file in small chunks. After every
+   flush assetsPrefetch() decodes the frame most likely to come next into a
+   small cache, while the current one is still on the panel. The cache is
+   only allocated when the pack has clips for the firmware.
+
+   Clips with nothing drawn over them can skip the framebuffer: between
+   assetsStream(true) and assetsStream(false), assetsFlush() sends the frame
+   from the cache as it is, or from flash a transposed page at a time,
+   without clearing and filling the 1 KB framebuffer first.
+*/
+
+#define ASSET_PACK_PATH "/assets.pak"
+#define ASSET_PACK_VERSION 1
+#define ASSET_NAME_LENGTH 12
+#define ASSET_CACHE_SLOTS 2
+
+enum AssetClip : uint8_t {
+  CLIP_BLINK,
+  CLIP_SIDEEYE_0,
+  CLIP_SIDEEYE_1,
+  CLIP_PETTING,
+  CLIP_DIZZY,
+  CLIP_SLEEP,
+  CLIP_STUDY,
+  CLIP_SPLASH,
+  CLIP_MEMES,  // the only clip a pack may give more frames than the built-in one
+  CLIP_COUNT
+};
+
+void assetsBegin();
+byte assetFrames(AssetClip clip);
+const uint8_t *assetBitmap(AssetClip clip, byte frame);
+void assetDraw(AssetClip clip, byte frame);
+void assetsStream(bool on);
+void assetsFlush();
+void assetsPrefetch();
+void assetsDump(Print &out);
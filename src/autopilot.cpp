@@ -0,0 +1,122 @@
+#include "autopilot.h"
+#include "flappy.h"
+
+/**
+ * decides whether to flap this frame. keeps the bird just above the bottom of the
+ * gap it still has to get through, falling is free and a flap always rises right away
+ */
+bool autopilotShouldFlap(const FlappyGame &game) {
+  // nearest wall the bird hasn't fully passed yet
+  int next = -1;
+  for (int i = 0; i < 2; i++) {
+    if (game.wall_x[i] + game.wall_width > game.bird_x && (next < 0 || game.wall_x[i] < game.wall_x[next])) {
+      next = i;
+    }
+  }
+
+  int lowest = next < 0 ? display.height() / 2 : game.wall_y[next] + game.wall_gap - SPRITE_HEIGHT - 1;
+
+  // where the bird ends up next frame without a flap
+  return game.bird_y + game.momentum + 1 > lowest;
+}
+
+#ifdef MAO_AUTOPILOT
+
+#include "telemetry.h"
+#include "render.h"
+#include "transition.h"
+
+static bool playing = false;
+static unsigned long gameOverTime;
+static unsigned long reportTime;
+
+static uint32_t frames;
+static uint32_t lastFrameMicros;
+static uint32_t windowFrames;
+static uint32_t windowMin;
+static uint32_t windowMax;
+static uint32_t windowSum;
+static uint32_t heapMin = UINT32_MAX;
+
+static uint32_t games;
+static uint32_t lastScore;
+static uint32_t bestScore;
+static uint32_t totalScore;
+
+static void report() {
+  uint32_t values[11] = {
+    millis() / 1000,
+    frames,
+    flushCount,
+    windowFrames ? windowMin : 0,
+    windowFrames ? windowSum / windowFrames : 0,
+    windowMax,
+    heapMin,
+    games,
+    lastScore,
+    bestScore,
+    games ? totalScore / games : 0,
+  };
+  telemetryWrite(TLM_SOAK, values, sizeof(values));
+
+  windowFrames = 0;
+  windowMax = 0;
+  windowSum = 0;
+}
+
+/**
+ * runs before every flappy frame
+ */
+void autopilotFrame() {
+  uint32_t now = micros();
+  if (lastFrameMicros) {
+    uint32_t frameTime = now - lastFrameMicros;
+    if (windowFrames == 0 || frameTime < windowMin) {
+      windowMin = frameTime;
+    }
+    if (frameTime > windowMax) {
+      windowMax = frameTime;
+    }
+    windowSum += frameTime;
+    windowFrames++;
+  }
+  lastFrameMicros = now;
+  frames++;
+
+  uint32_t heap = ESP.getFreeHeap();
+  if (heap < heapMin) {
+    heapMin = heap;
+  }
+
+  FlappyGame *game = flappyGame();
+  if (game->game_state == 0) {
+    if (autopilotShouldFlap(*game)) {
+      game->momentum = -4;
+    }
+  } else if (playing) {
+    // first frame of the game over screen, score still holds the final result
+    playing = false;
+    games++;
+    lastScore = game->score;
+    totalScore += game->score;
+    if ((uint32_t)game->score > bestScore) {
+      bestScore = game->score;
+    }
+    gameOverTime = millis();
+  } else if (millis() - gameOverTime > AUTOPILOT_RESTART_DELAY) {
+    transitionStart(TRANSITION_WIPE, FLAPPY_WIPE_TIME);
+    game->game_state = 0;
+    playing = true;
+  }
+
+  if (millis() - reportTime > AUTOPILOT_REPORT_INTERVAL) {
+    report();
+    reportTime = millis();
+  }
+}
+
+#else
+
+void autopilotFrame() {}
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Flappy autopilot for unattended soak tests and frame rate benchmarks.
+
+   Build with -DMAO_AUTOPILOT (the d1_mini_soak env), the toy then boots straight
+   into flappy, plays and restarts games on its own, and sends a TLM_SOAK
+   telemetry record every AUTOPILOT_REPORT_INTERVAL with frame times, flush
+   count, heap watermark and scores.
+*/
+
+#define AUTOPILOT_RESTART_DELAY 1500    // ms on the game over screen before the next game
+#define AUTOPILOT_REPORT_INTERVAL 10000 // ms between soak reports
+
+#ifdef MAO_AUTOPILOT
+#define AUTOPILOT 1
+#else
+#define AUTOPILOT 0
+#endif
+
+struct FlappyGame;
+
+bool autopilotShouldFlap(const FlappyGame &game);
+void autopilotFrame();
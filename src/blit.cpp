@@ -0,0 +1,243 @@
+#include "blit.h"
+#include "framebuffer.h"
+#include "assets.h"
+#include "flappy.h"
+
+#define ROW_BYTES (SCREEN_WIDTH / 8)
+#define ROW_WORDS (SCREEN_WIDTH / 32)
+#define BENCH_ROUNDS 4
+#define BENCH_STEPS 64  // sprite and bar positions per variant
+
+static_assert(SCREEN_WIDTH % 32 == 0, "blitFrame() reads whole words per row");
+
+/**
+ * ORs a full-screen row-major bitmap into the framebuffer
+ */
+void blitFrame(const uint8_t *bitmap) {
+  if ((uintptr_t)bitmap & 3) {
+    blitFrameBytes(bitmap);
+    return;
+  }
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    blitPage(bitmap, p, display.getBuffer() + p * SCREEN_WIDTH);
+  }
+}
+
+/**
+ * ORs one page of a word aligned full-screen row-major bitmap into the
+ * SCREEN_WIDTH bytes at out. The page worth of rows comes out of flash as
+ * 32-bit loads, then every 8x8 block of it is transposed into 8 page bytes.
+ */
+void blitPage(const uint8_t *bitmap, uint8_t page, uint8_t *out) {
+  const uint32_t *src = (const uint32_t *)bitmap + page * 8 * ROW_WORDS;
+  uint32_t rows[8 * ROW_WORDS];
+  for (uint8_t i = 0; i < 8 * ROW_WORDS; i++) {
+    rows[i] = pgm_read_dword(src++);
+  }
+  // little endian, the bytes of the words are in screen order again
+  const uint8_t *bytes = (const uint8_t *)rows;
+  for (uint8_t c = 0; c < ROW_BYTES; c++) {
+    transposeRows(bytes + c, ROW_BYTES, out + c * 8);
+  }
+}
+
+/**
+ * the same with a pgm_read_byte() per 8 pixels, for bitmaps that are not
+ * word aligned and as the benchmark baseline
+ */
+void blitFrameBytes(const uint8_t *bitmap) {
+  uint8_t rows[8 * ROW_BYTES];
+  uint8_t *page = display.getBuffer();
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++, page += SCREEN_WIDTH) {
+    for (uint8_t i = 0; i < 8 * ROW_BYTES; i++) {
+      rows[i] = pgm_read_byte(bitmap++);
+    }
+    for (uint8_t c = 0; c < ROW_BYTES; c++) {
+      transposeRows(rows + c, ROW_BYTES, page + c * 8);
+    }
+  }
+}
+
+/**
+ * converts a row-major bitmap in RAM to page layout, width a multiple of 8.
+ * pages needs width * ceil(height / 8) bytes, a short last page is padded
+ * with blank rows.
+ */
+void bitmapToPages(const uint8_t *bitmap, uint16_t width, uint16_t height, uint8_t *pages) {
+  uint16_t stride = width / 8;
+  memset(pages, 0, width * ((height + 7) / 8));
+  for (uint16_t top = 0; top < height; top += 8, pages += width) {
+    const uint8_t *rows = bitmap + top * stride;
+    if (top + 8 <= height) {
+      for (uint16_t c = 0; c < stride; c++) {
+        transposeRows(rows + c, stride, pages + c * 8);
+      }
+      continue;
+    }
+    for (uint16_t c = 0; c < stride; c++) {
+      uint8_t last[8] = {};
+      for (uint8_t r = 0; r < height - top; r++) {
+        last[r] = rows[r * stride + c];
+      }
+      transposeRows(last, 1, pages + c * 8);
+    }
+  }
+}
+
+#ifdef MAO_PROFILE
+
+typedef void (*BlitFunction)(const uint8_t *bitmap);
+
+static void clearOnly(const uint8_t *) {}
+
+static void drawBitmapFrame(const uint8_t *bitmap) {
+  display.drawBitmap(0, 0, bitmap, SCREEN_WIDTH, SCREEN_HEIGHT, WHITE);
+}
+
+// us per frame, the clear before each frame included
+static uint32_t timeBlit(BlitFunction blit) {
+  uint8_t frames = assetFrames(CLIP_BLINK);
+  uint32_t start = ESP.getCycleCount();
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    for (uint8_t f = 0; f < frames; f++) {
+      display.clearDisplay();
+      blit(assetBitmap(CLIP_BLINK, f));
+    }
+  }
+  return (ESP.getCycleCount() - start) / ESP.getCpuFreqMHz() / (BENCH_ROUNDS * frames);
+}
+
+// true when blit draws every blink frame exactly like drawBitmap()
+static bool sameAsDrawBitmap(BlitFunction blit) {
+  static uint8_t expected[SCREEN_WIDTH * SCREEN_PAGES];
+  for (uint8_t f = 0; f < assetFrames(CLIP_BLINK); f++) {
+    display.clearDisplay();
+    drawBitmapFrame(assetBitmap(CLIP_BLINK, f));
+    memcpy(expected, display.getBuffer(), sizeof(expected));
+    display.clearDisplay();
+    blit(assetBitmap(CLIP_BLINK, f));
+    if (memcmp(expected, display.getBuffer(), sizeof(expected))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the per-pixel conversion bitmapToPages() replaces
+static void pixelsToPages(const uint8_t *bitmap, uint16_t width, uint16_t height, uint8_t *pages) {
+  uint16_t stride = width / 8;
+  memset(pages, 0, width * ((height + 7) / 8));
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      if (bitmap[y * stride + x / 8] & (0x80 >> (x & 7))) {
+        pages[y / 8 * width + x] |= 1 << (y & 7);
+      }
+    }
+  }
+}
+
+typedef void (*ConvertFunction)(const uint8_t *bitmap, uint16_t width, uint16_t height, uint8_t *pages);
+
+// cycles per page byte for converting the first blink frame out of RAM
+static uint32_t timeConvert(ConvertFunction convert, const uint8_t *source) {
+  uint32_t start = ESP.getCycleCount();
+  for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+    convert(source, SCREEN_WIDTH, SCREEN_HEIGHT, display.getBuffer());
+  }
+  return (ESP.getCycleCount() - start) / (BENCH_ROUNDS * SCREEN_WIDTH * SCREEN_PAGES);
+}
+
+// one draw of a variant at position step of BENCH_STEPS
+typedef void (*DrawFunction)(uint8_t step);
+
+static const PageSprite<SPRITE_WIDTH, SPRITE_HEIGHT> benchBird(wing_up_bmp);
+
+// the bird's column, every height the game lets it fly at
+static int16_t birdY(uint8_t step) {
+  return step % (SCREEN_HEIGHT - SPRITE_HEIGHT + 1);
+}
+
+static void birdDrawBitmap(uint8_t step) {
+  display.drawBitmap(SCREEN_WIDTH / 4, birdY(step), wing_up_bmp, SPRITE_WIDTH, SPRITE_HEIGHT, WHITE);
+}
+
+static void birdClipped(uint8_t step) {
+  benchBird.draw<WHITE, true>(SCREEN_WIDTH / 4, birdY(step));
+}
+
+static void birdUnclipped(uint8_t step) {
+  benchBird.draw<WHITE, false>(SCREEN_WIDTH / 4, birdY(step));
+}
+
+// a wall sliding in from the right edge and out at the left, gap moving
+static int16_t wallX(uint8_t step) {
+  return SCREEN_WIDTH - step * 3;
+}
+
+static int16_t wallGap(uint8_t step) {
+  return step % (SCREEN_HEIGHT - 30);
+}
+
+static void wallFillRect(uint8_t step) {
+  display.fillRect(wallX(step), 0, 10, wallGap(step), WHITE);
+  display.fillRect(wallX(step), wallGap(step) + 30, 10, SCREEN_HEIGHT - wallGap(step) - 30, WHITE);
+}
+
+static void wallFillBar(uint8_t step) {
+  fillBar<WHITE, true>(wallX(step), 0, 10, wallGap(step));
+  fillBar<WHITE, true>(wallX(step), wallGap(step) + 30, 10, SCREEN_HEIGHT - wallGap(step) - 30);
+}
+
+// cycles per draw, without clearing in between
+static uint32_t timeDraw(DrawFunction draw) {
+  display.clearDisplay();
+  uint32_t start = ESP.getCycleCount();
+  for (uint8_t step = 0; step < BENCH_STEPS; step++) {
+    draw(step);
+  }
+  return (ESP.getCycleCount() - start) / BENCH_STEPS;
+}
+
+// true when both leave the same framebuffer at every step
+static bool sameDraw(DrawFunction draw, DrawFunction reference) {
+  static uint8_t expected[SCREEN_WIDTH * SCREEN_PAGES];
+  for (uint8_t step = 0; step < BENCH_STEPS; step++) {
+    display.clearDisplay();
+    reference(step);
+    memcpy(expected, display.getBuffer(), sizeof(expected));
+    display.clearDisplay();
+    draw(step);
+    if (memcmp(expected, display.getBuffer(), sizeof(expected))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * full-frame blits of the blink clip, then the flappy sprite and walls.
+ * the next frame redraws the panel
+ */
+void blitBenchmark(Print &out) {
+  out.printf("blit, us per %ux%u frame of blink at %u MHz\n", SCREEN_WIDTH, SCREEN_HEIGHT, ESP.getCpuFreqMHz());
+  out.printf("  clear only   %5u\n", timeBlit(clearOnly));
+  out.printf("  drawBitmap   %5u\n", timeBlit(drawBitmapFrame));
+  out.printf("  byte reads   %5u %s\n", timeBlit(blitFrameBytes), sameAsDrawBitmap(blitFrameBytes) ? "ok" : "MISMATCH");
+  out.printf("  word reads   %5u %s\n", timeBlit(blitFrame), sameAsDrawBitmap(blitFrame) ? "ok" : "MISMATCH");
+
+  // a frame that only exists in RAM, like a downloaded image
+  static uint8_t source[SCREEN_WIDTH * SCREEN_PAGES];
+  memcpy_P(source, assetBitmap(CLIP_BLINK, 0), sizeof(source));
+  out.println(F("row-major to pages from RAM, cycles per page byte"));
+  out.printf("  per pixel    %5u\n", timeConvert(pixelsToPages, source));
+  out.printf("  transpose8   %5u\n", timeConvert(bitmapToPages, source));
+
+  out.println(F("flappy, cycles per draw"));
+  out.printf("  bird drawBitmap  %5u\n", timeDraw(birdDrawBitmap));
+  out.printf("  bird clipped     %5u %s\n", timeDraw(birdClipped), sameDraw(birdClipped, birdDrawBitmap) ? "ok" : "MISMATCH");
+  out.printf("  bird unclipped   %5u %s\n", timeDraw(birdUnclipped), sameDraw(birdUnclipped, birdDrawBitmap) ? "ok" : "MISMATCH");
+  out.printf("  walls fillRect   %5u\n", timeDraw(wallFillRect));
+  out.printf("  walls fillBar    %5u %s\n", timeDraw(wallFillBar), sameDraw(wallFillBar, wallFillRect) ? "ok" : "MISMATCH");
+}
+
+#endif
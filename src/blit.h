@@ -0,0 +1,205 @@
+#pragma once
+#include <Arduino.h>
+#include "framebuffer.h"
+
+/**
+   Fast paths for putting bitmaps into the framebuffer.
+
+   The ESP8266 reads PROGMEM through the instruction cache, where only
+   aligned 32-bit loads are native. Every pgm_read_byte() is a word load
+   plus a shift, and drawBitmap() does one per 8 pixels, followed by a
+   virtual drawPixel() per pixel. blitFrame() instead streams a full-screen
+   row-major bitmap with aligned 32-bit loads, a page of rows at a time. The
+   frame arrays are declared aligned(4) for it. Unaligned bitmaps take the
+   byte-wise blitFrameBytes().
+
+   Row-major bytes become page bytes through transpose8(), an 8x8 bit
+   transpose done on two 32-bit words in a dozen shifts and masks, instead
+   of a test and set per pixel. Empty blocks, most of a face frame, are
+   skipped. bitmapToPages() uses it to convert row-major bitmaps that only
+   exist at runtime.
+
+   Smaller things are drawn by templates fixed at compile time on size,
+   colour and whether they can leave the screen. PageSprite keeps a sprite
+   in page layout, so drawing it is a shift and a few ORs per column at any
+   y. fillBar() is fillRect() with one mask per page instead of a masked
+   byte per pixel column and page. Whatever does not fit them still goes
+   through drawBitmap() and fillRect().
+
+   With -DMAO_PROFILE, sending 'b' over Serial benchmarks all of this against
+   the per-pixel paths on the blink clip.
+*/
+
+/**
+ * transposes an 8x8 bit block in place. Going in, x holds rows 7..4 and y
+ * rows 3..0, one row per byte from the top byte down, leftmost pixel in the
+ * MSB. Coming out, x holds columns 0..3 and y columns 4..7 in the same byte
+ * order, as page bytes with row 0 in the LSB.
+ */
+static inline void transpose8(uint32_t &x, uint32_t &y) {
+  uint32_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+}
+
+/**
+ * 8 row bytes, stride bytes apart, to the 8 page bytes at out, ORed in
+ */
+static inline void transposeRows(const uint8_t *rows, uint16_t stride, uint8_t *out) {
+  uint32_t x = (uint32_t)rows[7 * stride] << 24 | rows[6 * stride] << 16 | rows[5 * stride] << 8 | rows[4 * stride];
+  uint32_t y = (uint32_t)rows[3 * stride] << 24 | rows[2 * stride] << 16 | rows[stride] << 8 | rows[0];
+  if (!(x | y)) {
+    return;
+  }
+  transpose8(x, y);
+  out[0] |= x >> 24;
+  out[1] |= x >> 16;
+  out[2] |= x >> 8;
+  out[3] |= x;
+  out[4] |= y >> 24;
+  out[5] |= y >> 16;
+  out[6] |= y >> 8;
+  out[7] |= y;
+}
+
+void blitFrame(const uint8_t *bitmap);
+void blitPage(const uint8_t *bitmap, uint8_t page, uint8_t *out);
+void blitFrameBytes(const uint8_t *bitmap);
+void bitmapToPages(const uint8_t *bitmap, uint16_t width, uint16_t height, uint8_t *pages);
+
+/**
+ * bits of a page for the rows top..bottom, 0 when the page has none of them
+ */
+static inline uint8_t rowMask(uint8_t page, int16_t top, int16_t bottom) {
+  int16_t first = max(top - page * 8, 0);
+  int16_t last = min(bottom - page * 8, 7);
+  return first > last ? 0 : (0xFF >> (7 - last)) & (0xFF << first);
+}
+
+template <uint8_t Color>
+static inline void paintBits(uint8_t *b, uint8_t mask) {
+  if (Color == WHITE) {
+    *b |= mask;
+  } else if (Color == BLACK) {
+    *b &= ~mask;
+  } else {
+    *b ^= mask;
+  }
+}
+
+/**
+ * a W x H sprite converted once from a row-major PROGMEM bitmap, the kind
+ * drawBitmap() takes. draw() with Clip false is for call sites that keep
+ * the sprite on screen, it leaves out every bounds check.
+ */
+template <uint8_t W, uint8_t H>
+class PageSprite {
+  static_assert(W % 8 == 0, "bitmapToPages() converts whole bytes");
+  static_assert(H <= 24, "a shifted column has to fit a word");
+
+ public:
+  explicit PageSprite(const uint8_t *bitmap) {
+    uint8_t rows[W / 8 * H];
+    memcpy_P(rows, bitmap, sizeof(rows));
+    bitmapToPages(rows, W, H, pages);
+  }
+
+  template <uint8_t Color, bool Clip>
+  void draw(int16_t x, int16_t y) const {
+    uint8_t first = 0, last = W;
+    if (Clip) {
+      if (x >= SCREEN_WIDTH || x + W <= 0 || y >= SCREEN_HEIGHT || y + H <= 0) {
+        return;
+      }
+      if (x < 0) {
+        first = -x;
+      }
+      if (x + W > SCREEN_WIDTH) {
+        last = SCREEN_WIDTH - x;
+      }
+    }
+    uint8_t shift = y & 7;
+    int8_t top = y >> 3;  // rounds down above the screen too
+    uint8_t spans = (shift + H + 7) / 8;
+    uint8_t *out = display.getBuffer() + x;
+    for (uint8_t c = first; c < last; c++) {
+      uint32_t column = 0;
+      for (uint8_t p = 0; p < PAGES; p++) {
+        column |= (uint32_t)pages[p * W + c] << (8 * p);
+      }
+      column <<= shift;
+      for (uint8_t p = 0; p < spans; p++) {
+        int8_t page = top + p;
+        if (Clip && (page < 0 || page >= SCREEN_PAGES)) {
+          continue;
+        }
+        paintBits<Color>(out + page * SCREEN_WIDTH + c, column >> (8 * p));
+      }
+    }
+  }
+
+ private:
+  static const uint8_t PAGES = (H + 7) / 8;
+  uint8_t pages[W * PAGES];
+};
+
+/**
+ * fillRect() for walls and bands: the mask of each page is worked out once
+ * and solid pages are a memset
+ */
+template <uint8_t Color, bool Clip>
+static inline void fillBar(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (Clip) {
+    if (x < 0) {
+      w += x;
+      x = 0;
+    }
+    if (y < 0) {
+      h += y;
+      y = 0;
+    }
+    if (x + w > SCREEN_WIDTH) {
+      w = SCREEN_WIDTH - x;
+    }
+    if (y + h > SCREEN_HEIGHT) {
+      h = SCREEN_HEIGHT - y;
+    }
+    if (w <= 0 || h <= 0) {
+      return;
+    }
+  }
+  int16_t bottom = y + h;
+  for (uint8_t page = y / 8; page * 8 < bottom; page++) {
+    uint8_t mask = 0xFF;
+    if (page == y / 8) {
+      mask <<= y & 7;
+    }
+    if (page * 8 + 8 > bottom) {
+      mask &= 0xFF >> (page * 8 + 8 - bottom);
+    }
+    uint8_t *b = display.getBuffer() + page * SCREEN_WIDTH + x;
+    if (mask == 0xFF && Color != INVERSE) {
+      memset(b, Color == WHITE ? 0xFF : 0x00, w);
+      continue;
+    }
+    for (int16_t i = 0; i < w; i++) {
+      paintBits<Color>(b + i, mask);
+    }
+  }
+}
+
+
+#ifdef MAO_PROFILE
+void blitBenchmark(Print &out);
+#else
+static inline void blitBenchmark(Print &) {}
+#endif
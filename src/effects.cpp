@@ -0,0 +1,254 @@
+#include "effects.h"
+#include "framebuffer.h"
+#include "render.h"
+
+#ifdef FX_SOFTWARE
+#define FX_HARDWARE 0
+#else
+#define FX_HARDWARE 1
+#endif
+
+// the SH1106 inverts and dims like the SSD1306 but has no scroll engine
+#if defined(FX_SOFTWARE) || defined(PANEL_SH1106)
+#define FX_HARDWARE_SCROLL 0
+#else
+#define FX_HARDWARE_SCROLL 1
+#endif
+
+static bool inverted = false;
+static unsigned long flashEnd = 0;
+
+static uint8_t contrast = FX_CONTRAST_DEFAULT;
+static uint8_t fadeFrom;
+static uint8_t fadeTo;
+static unsigned long fadeStart;
+static uint16_t fadeTime = 0;
+static uint16_t breathePeriod = 0;
+
+static FxScroll scrolling = FX_SCROLL_NONE;
+static uint16_t scrollStep;  // ms per step, for the software fallback
+static unsigned long scrollTime;
+
+static void setInvert(bool on) {
+  if (FX_HARDWARE) {
+    display.invertDisplay(on);
+  }
+  inverted = on;
+}
+
+void fxInvert(bool on) {
+  flashEnd = 0;
+  setInvert(on);
+}
+
+/**
+ * inverts the panel for a moment
+ */
+void fxFlash(uint16_t duration) {
+  setInvert(!inverted);
+  flashEnd = millis() + duration;
+  if (!flashEnd) {
+    flashEnd = 1;
+  }
+}
+
+static void setContrast(uint8_t level) {
+  if (level == contrast) {
+    return;
+  }
+  contrast = level;
+  if (FX_HARDWARE) {
+    const uint8_t set[] = { SSD1306_SETCONTRAST, level };
+    panel.commands(set, sizeof(set));
+  }
+}
+
+void fxContrast(uint8_t level) {
+  fadeTime = 0;
+  breathePeriod = 0;
+  setContrast(level);
+}
+
+/**
+ * ramps the contrast from where it is now to the given level
+ */
+void fxFade(uint8_t to, uint16_t duration) {
+  breathePeriod = 0;
+  fadeFrom = contrast;
+  fadeTo = to;
+  fadeStart = millis();
+  fadeTime = duration ? duration : 1;
+}
+
+/**
+ * keeps ramping the contrast up and down between two levels
+ */
+void fxBreathe(uint8_t low, uint8_t high, uint16_t period) {
+  fadeFrom = low;
+  fadeTo = high;
+  fadeStart = millis();
+  fadeTime = 0;
+  breathePeriod = period;
+}
+
+/**
+ * starts a continuous scroll of the whole frame
+ */
+void fxScroll(FxScroll direction, FxScrollSpeed speed) {
+  if (scrolling != FX_SCROLL_NONE) {
+    fxScroll(FX_SCROLL_NONE, speed);
+  }
+
+  scrolling = direction;
+  scrollTime = millis();
+
+  static const uint16_t framesPerStep[8] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+  scrollStep = framesPerStep[speed] * 10;  // the panel runs at roughly 100 Hz
+
+  if (!FX_HARDWARE_SCROLL) {
+    return;
+  }
+
+  if (direction == FX_SCROLL_NONE) {
+    panel.command(SSD1306_DEACTIVATE_SCROLL);
+    return;
+  }
+
+  // the whole setup goes out in one transfer
+  uint8_t lastPage = SCREEN_PAGES - 1;
+  if (direction == FX_SCROLL_LEFT || direction == FX_SCROLL_RIGHT) {
+    uint8_t op = direction == FX_SCROLL_LEFT ? SSD1306_LEFT_HORIZONTAL_SCROLL : SSD1306_RIGHT_HORIZONTAL_SCROLL;
+    const uint8_t start[] = {
+      op, 0x00, 0, speed, lastPage, 0x00, 0xFF,
+      SSD1306_ACTIVATE_SCROLL,
+    };
+    panel.commands(start, sizeof(start));
+  } else {
+    uint8_t op = direction == FX_SCROLL_DIAG_LEFT ? SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL : SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL;
+    const uint8_t start[] = {
+      SSD1306_SET_VERTICAL_SCROLL_AREA, 0, SCREEN_HEIGHT,
+      op, 0x00, 0, speed, lastPage, 0x01,
+      SSD1306_ACTIVATE_SCROLL,
+    };
+    panel.commands(start, sizeof(start));
+  }
+}
+
+bool fxScrolling() {
+  return scrolling != FX_SCROLL_NONE;
+}
+
+/**
+ * true while a software fallback works on the framebuffer, frames have to
+ * go through it then
+ */
+bool fxEditsFrame() {
+  return (!FX_HARDWARE && inverted) || (!FX_HARDWARE_SCROLL && scrolling != FX_SCROLL_NONE);
+}
+
+/**
+ * back to a plain panel, used on mode changes
+ */
+void fxReset() {
+  if (scrolling != FX_SCROLL_NONE) {
+    fxScroll(FX_SCROLL_NONE, FX_SPEED_5);
+  }
+  if (inverted) {
+    fxInvert(false);
+  }
+  flashEnd = 0;
+  fxContrast(FX_CONTRAST_DEFAULT);
+}
+
+/**
+ * moves the framebuffer one step, the software version of the controller scroll
+ */
+static void scrollBuffer() {
+  uint8_t *buffer = display.getBuffer();
+  int16_t width = display.width();
+  uint8_t pages = display.height() / 8;
+  bool left = scrolling == FX_SCROLL_LEFT || scrolling == FX_SCROLL_DIAG_LEFT;
+
+  for (uint8_t p = 0; p < pages; p++) {
+    uint8_t *row = buffer + p * width;
+    if (left) {
+      uint8_t first = row[0];
+      memmove(row, row + 1, width - 1);
+      row[width - 1] = first;
+    } else {
+      uint8_t last = row[width - 1];
+      memmove(row + 1, row, width - 1);
+      row[0] = last;
+    }
+  }
+
+  if (scrolling == FX_SCROLL_DIAG_LEFT || scrolling == FX_SCROLL_DIAG_RIGHT) {
+    // one row up, every column rotates through its pages
+    for (int16_t x = 0; x < width; x++) {
+      uint8_t carry = buffer[x] & 1;
+      for (int8_t p = pages - 1; p >= 0; p--) {
+        uint8_t *b = buffer + p * width + x;
+        uint8_t out = *b & 1;
+        *b = (*b >> 1) | (carry << 7);
+        carry = out;
+      }
+    }
+  }
+}
+
+void fxUpdate() {
+  unsigned long now = millis();
+
+  if (flashEnd && (long)(now - flashEnd) >= 0) {
+    flashEnd = 0;
+    setInvert(!inverted);
+  }
+
+  if (fadeTime) {
+    unsigned long t = now - fadeStart;
+    if (t >= fadeTime) {
+      fadeTime = 0;
+      setContrast(fadeTo);
+    } else {
+      setContrast(fadeFrom + ((int32_t)fadeTo - fadeFrom) * (int32_t)t / fadeTime);
+    }
+  } else if (breathePeriod) {
+    // triangle wave between the two levels
+    uint16_t t = (now - fadeStart) % breathePeriod;
+    uint16_t half = breathePeriod / 2;
+    uint16_t up = t < half ? t : breathePeriod - t;
+    setContrast(fadeFrom + ((int32_t)fadeTo - fadeFrom) * up / half);
+  }
+
+  if (!FX_HARDWARE_SCROLL && scrolling != FX_SCROLL_NONE && now - scrollTime >= scrollStep) {
+    scrollTime = now;
+    scrollBuffer();
+    flushDisplay();
+  }
+}
+
+static void invertBuffer() {
+  uint32_t *words = (uint32_t *)display.getBuffer();
+  for (uint16_t i = 0; i < SCREEN_WIDTH * SCREEN_PAGES / 4; i++) {
+    words[i] = ~words[i];
+  }
+}
+
+/**
+ * software inversion is applied only while the buffer is sent out
+ */
+void fxBeforeFlush() {
+  // writing the display RAM while the controller scrolls garbles it
+  if (FX_HARDWARE_SCROLL && scrolling != FX_SCROLL_NONE) {
+    fxScroll(FX_SCROLL_NONE, FX_SPEED_5);
+  }
+  if (!FX_HARDWARE && inverted) {
+    invertBuffer();
+  }
+}
+
+void fxAfterFlush() {
+  if (!FX_HARDWARE && inverted) {
+    invertBuffer();
+  }
+}
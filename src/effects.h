@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Display effects done by the SSD1306 controller itself: inversion, contrast
+   fades and continuous scrolling only cost a few command bytes instead of
+   re-flushing the framebuffer.
+
+   Build with -DFX_SOFTWARE for panels without these features, inversion and
+   scrolling then fall back to editing the framebuffer and flushing it.
+   Contrast has no software equivalent and is simply skipped there. SH1106
+   builds only take the fallback for scrolling.
+   Call fxUpdate() every loop(), it drives the time based effects.
+*/
+
+#define FX_CONTRAST_DEFAULT 0xCF  // what Panel::begin() sets
+
+enum FxScroll : uint8_t {
+  FX_SCROLL_NONE,
+  FX_SCROLL_LEFT,
+  FX_SCROLL_RIGHT,
+  FX_SCROLL_DIAG_LEFT,   // left and up
+  FX_SCROLL_DIAG_RIGHT,  // right and up
+};
+
+// Scroll step intervals in panel frames, values are the SSD1306 encoding
+enum FxScrollSpeed : uint8_t {
+  FX_SPEED_2 = 7,
+  FX_SPEED_3 = 4,
+  FX_SPEED_5 = 0,
+  FX_SPEED_25 = 6,
+  FX_SPEED_64 = 1,
+};
+
+void fxInvert(bool on);
+void fxFlash(uint16_t duration);
+void fxContrast(uint8_t level);
+void fxFade(uint8_t to, uint16_t duration);
+void fxBreathe(uint8_t low, uint8_t high, uint16_t period);
+void fxScroll(FxScroll direction, FxScrollSpeed speed);
+bool fxScrolling();
+bool fxEditsFrame();
+void fxReset();
+void fxUpdate();
+
+void fxBeforeFlush();
+void fxAfterFlush();
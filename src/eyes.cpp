@@ -0,0 +1,172 @@
+#include "eyes.h"
+#include "framebuffer.h"
+#include "blit.h"
+#include "render.h"
+#include "tilt.h"
+#include "transition.h"
+#include "arena.h"
+
+#define EYE_RADIUS (SCREEN_HEIGHT / 2 - 2 < 26 ? SCREEN_HEIGHT / 2 - 2 : 26)
+#define PUPIL_RADIUS (EYE_RADIUS * 2 / 5)
+#define PUPIL_TRAVEL (EYE_RADIUS - PUPIL_RADIUS - 2)  // pupils stay inside the whites
+#define EYE_Y (SCREEN_HEIGHT / 2)
+
+// how the MPU sits on the board, the pupils roll towards the lower side
+#define EYES_SIGN_X -1
+#define EYES_SIGN_Y 1
+#define EYES_GAIN 2  // full travel at half a g, about 30 degrees of tilt
+
+struct Eye {
+  int16_t x;  // center of the white
+  int8_t dx;  // pupil offset from it
+  int8_t dy;
+};
+
+// the mode's working state, in the mode arena while the eyes are up
+struct EyesState {
+  Eye eyes[2] = {
+    { SCREEN_WIDTH / 4, 0, 0 },
+    { SCREEN_WIDTH * 3 / 4, 0, 0 },
+  };
+  int8_t eyeHalf[EYE_RADIUS + 1];  // half height of the white by distance from its center column
+  int8_t pupilHalf[PUPIL_RADIUS + 1];
+  bool drawn = false;
+
+  EyesState();
+  void drawEye(const Eye &eye, int16_t left, int16_t right, uint8_t firstPage, uint8_t lastPage);
+  bool frame();
+};
+
+ARENA_REPORT(eyes, EyesState)
+
+static void discHalves(int8_t *half, int16_t radius) {
+  int16_t h = radius;
+  for (int16_t dx = 0; dx <= radius; dx++) {
+    while (h * h + dx * dx > radius * radius) {
+      h--;
+    }
+    half[dx] = h;
+  }
+}
+
+static uint16_t isqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > n) {
+    bit >>= 2;
+  }
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+/**
+ * pupil offset for the filtered tilt, kept on a circle of PUPIL_TRAVEL
+ */
+static void gaze(int8_t &dx, int8_t &dy) {
+  TiltVector a = tiltFiltered();
+  int32_t x = (int32_t)EYES_SIGN_X * a.x * PUPIL_TRAVEL * EYES_GAIN / TILT_ONE_G;
+  int32_t y = (int32_t)EYES_SIGN_Y * a.y * PUPIL_TRAVEL * EYES_GAIN / TILT_ONE_G;
+  uint32_t length = isqrt(x * x + y * y);
+  if (length > PUPIL_TRAVEL) {
+    x = x * PUPIL_TRAVEL / (int32_t)length;
+    y = y * PUPIL_TRAVEL / (int32_t)length;
+  }
+  dx = x;
+  dy = y;
+}
+
+/**
+ * writes the columns left..right of an eye on the pages first..last: the
+ * white, the pupil cut out of it and a glint on the pupil
+ */
+void EyesState::drawEye(const Eye &eye, int16_t left, int16_t right, uint8_t firstPage, uint8_t lastPage) {
+  int16_t pupilX = eye.x + eye.dx;
+  int16_t pupilY = EYE_Y + eye.dy;
+  int16_t glintX = pupilX - PUPIL_RADIUS / 2;
+  int16_t glintY = pupilY - PUPIL_RADIUS / 2;
+  for (int16_t x = left; x <= right; x++) {
+    uint8_t fromEye = abs(x - eye.x);
+    uint8_t fromPupil = abs(x - pupilX);
+    int8_t white = fromEye <= EYE_RADIUS ? eyeHalf[fromEye] : -1;
+    int8_t pupil = fromPupil <= PUPIL_RADIUS ? pupilHalf[fromPupil] : -1;
+    bool glint = x >= glintX - 1 && x <= glintX;
+    uint8_t *b = display.getBuffer() + firstPage * SCREEN_WIDTH + x;
+    for (uint8_t page = firstPage; page <= lastPage; page++, b += SCREEN_WIDTH) {
+      uint8_t bits = rowMask(page, EYE_Y - white, EYE_Y + white) & ~rowMask(page, pupilY - pupil, pupilY + pupil);
+      if (glint) {
+        bits |= rowMask(page, glintY - 1, glintY);
+      }
+      *b = bits;
+    }
+  }
+}
+
+/**
+ * the first frame draws the whole face
+ */
+EyesState::EyesState() {
+  discHalves(eyeHalf, EYE_RADIUS);
+  discHalves(pupilHalf, PUPIL_RADIUS);
+  tiltReset();
+}
+
+/**
+ * sets the eyes up in the mode arena
+ */
+void eyesEnter() {
+  arenaEnter<EyesState>(ARENA_EYES);
+}
+
+/**
+ * true when it drew the whole frame for the caller to flush, otherwise it
+ * sent the pupils itself
+ */
+bool eyesFrame() {
+  return arenaState<EyesState>(ARENA_EYES)->frame();
+}
+
+bool EyesState::frame() {
+  int8_t dx, dy;
+  if (tiltSample()) {
+    gaze(dx, dy);
+  } else {
+    dx = eyes[0].dx;
+    dy = eyes[0].dy;
+  }
+
+  // a transition composes whole frames, give it one
+  if (!drawn || transitionActive()) {
+    display.clearDisplay();
+    for (Eye &eye : eyes) {
+      eye.dx = dx;
+      eye.dy = dy;
+      drawEye(eye, eye.x - EYE_RADIUS, eye.x + EYE_RADIUS, 0, SCREEN_PAGES - 1);
+    }
+    drawn = true;
+    return true;
+  }
+
+  for (Eye &eye : eyes) {
+    if (eye.dx == dx && eye.dy == dy) {
+      continue;
+    }
+    // where the pupil was and where it goes, glint included
+    int16_t left = eye.x + min(eye.dx, dx) - PUPIL_RADIUS - 1;
+    int16_t right = eye.x + max(eye.dx, dx) + PUPIL_RADIUS;
+    uint8_t firstPage = (EYE_Y + min(eye.dy, dy) - PUPIL_RADIUS - 1) / 8;
+    uint8_t lastPage = (EYE_Y + max(eye.dy, dy) + PUPIL_RADIUS) / 8;
+    eye.dx = dx;
+    eye.dy = dy;
+    drawEye(eye, left, right, firstPage, lastPage);
+    flushDisplayWindow(firstPage, lastPage, left, right);
+  }
+  return false;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Eyes whose pupils follow the tilt of the toy.
+
+   The eye whites are a static layer, the pupils move over them. The first
+   frame draws and flushes the whole face, after that eyesFrame() samples
+   the accelerometer (tilt.h) and only redraws and sends the windows the
+   pupils moved over, a few hundred bytes instead of the full frame. That
+   keeps the mode at EYES_PERIOD with time to spare.
+*/
+
+#define EYES_PERIOD 25  // ms per frame, 40 fps
+
+void eyesEnter();
+bool eyesFrame();
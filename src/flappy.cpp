@@ -1,5 +1,11 @@
 #include "flappy.h"
 #include <EEPROM.h>
+#include "telemetry.h"
+#include "render.h"
+#include "anim.h"
+#include "blit.h"
+#include "tilt.h"
+#include <glcdfont.c>  // the 5x7 font print() uses, 5 column bytes per glyph, top row in the LSB
 
 /**
    Nano Bird - a flappy bird clone for arduino nano, oled screen & push on switch
@@ -10,20 +16,85 @@
 */
 
 // Game variables
-#define GAME_SPEED 50
-
-int game_state = 1; // 0 = game over screen, 1 = in game
-int score = 0; // current game score
-int high_score = 0; // highest score since the nano was reset
-int bird_x = (int)display.width() / 4; // birds x position (along) - initialised to 1/4 the way along the screen
-int bird_y; // birds y position (down)
-int momentum = 0; // how much force is pulling the bird down
-int wall_x[2]; // an array to hold the walls x positions
-int wall_y[2]; // an array to hold the walls y positions
-int wall_gap = 30; // size of the wall wall_gap in pixels
-int wall_width = 10; // width of the wall in pixels
+#define GAME_SPEED 80 // frame period in ms, what delay(50) plus the flush used to add up to
+
+bool tilt_control = false; // steer by tilting the toy instead of tapping
+
+// Tilt control, the bird rolls towards the lower edge like a marble
+#define FLAPPY_TILT_SIGN 1 // how the MPU sits on the board, same as the eyes
+#define FLAPPY_TILT_DEAD (TILT_ONE_G / 16) // about 4 degrees either side of level hovers
+#define FLAPPY_TILT_FULL (TILT_ONE_G / 2) // about 30 degrees climbs or dives at full speed
+#define FLAPPY_TILT_SUBPIXEL 16 // speed and position steps per pixel
+#define FLAPPY_TILT_SPEED (4 * FLAPPY_TILT_SUBPIXEL) // full speed, as fast as a flap rises
+#define FLAPPY_TILT_BUDGET 1000 // us a sample may take before the game stops asking for a while
+#define FLAPPY_TILT_BACKOFF 25 // frames without sampling after a slow one, 2 s
+
+static const PageSprite<SPRITE_WIDTH, SPRITE_HEIGHT> wingDown(wing_down_bmp);
+static const PageSprite<SPRITE_WIDTH, SPRITE_HEIGHT> wingUp(wing_up_bmp);
+
+ARENA_REPORT(flappy, FlappyGame)
+
+/**
+ * sets up the game in the mode arena, a game already there carries on
+ */
+void flappyEnter() {
+  arenaEnter<FlappyGame>(ARENA_FLAPPY);
+}
+
+/**
+ * one burst read per frame, right before the physics use it. A read that
+ * took longer than FLAPPY_TILT_BUDGET, a stretched or stuck bus, pauses sampling
+ * and the bird keeps its last speed
+ */
+void FlappyGame::sampleTilt() {
+  if (tiltBackoff) {
+    tiltBackoff--;
+    return;
+  }
+  uint32_t start = micros();
+  tiltSample();
+  if (micros() - start > FLAPPY_TILT_BUDGET) {
+    tiltBackoff = FLAPPY_TILT_BACKOFF;
+  }
+}
+
+/**
+ * vertical speed for the filtered tilt in 1/FLAPPY_TILT_SUBPIXEL pixels per frame,
+ * positive is down
+ */
+static int16_t tiltSpeed() {
+  int32_t a = FLAPPY_TILT_SIGN * tiltFiltered().y;
+  if (a > FLAPPY_TILT_DEAD) {
+    a -= FLAPPY_TILT_DEAD;
+  } else if (a < -FLAPPY_TILT_DEAD) {
+    a += FLAPPY_TILT_DEAD;
+  } else {
+    a = 0;
+  }
+  int32_t speed = a * FLAPPY_TILT_SPEED / (FLAPPY_TILT_FULL - FLAPPY_TILT_DEAD);
+  return constrain(speed, -FLAPPY_TILT_SPEED, FLAPPY_TILT_SPEED);
+}
+
+/**
+ * moves the bird by the tilt instead of gravity and flaps
+ */
+void FlappyGame::tiltSteer() {
+  sampleTilt();
+
+  int16_t speed = tiltSpeed();
+  tiltFraction += speed;
+  bird_y += tiltFraction / FLAPPY_TILT_SUBPIXEL;
+  tiltFraction %= FLAPPY_TILT_SUBPIXEL;
+
+  // only picks the wing frame, negative while climbing
+  momentum = speed < 0 ? -1 : 0;
+}
 
 void flappyLoop() {
+  flappyGame()->loop();
+}
+
+void FlappyGame::loop() {
 
   if (game_state == 0) {
     // in game
@@ -36,11 +107,15 @@ void flappyLoop() {
     //   momentum = -4;
     // }
 
-    // increase the downward force on the bird
-    momentum += 1;
+    if (tilt_control) {
+      tiltSteer();
+    } else {
+      // increase the downward force on the bird
+      momentum += 1;
 
-    // add the downward force to the bird position to determine it's new position
-    bird_y += momentum;
+      // add the downward force to the bird position to determine it's new position
+      bird_y += momentum;
+    }
 
     // make sure the bird doesn't fly off the top of the screen
     if (bird_y < 0 ) {
@@ -54,23 +129,23 @@ void flappyLoop() {
       momentum = -2;
     }
 
-    // display the bird
+    // display the bird, it never leaves the screen so it is drawn unclipped
     // if the momentum on the bird is negative the bird is going up!
     if (momentum < 0) {
 
       // display the bird using a randomly picked flap animation frame
       if (random(2) == 0) {
-        display.drawBitmap(bird_x, bird_y, wing_down_bmp, 16, 16, WHITE);
+        wingDown.draw<WHITE, false>(bird_x, bird_y);
       }
       else {
-        display.drawBitmap(bird_x, bird_y, wing_up_bmp, 16, 16, WHITE);
+        wingUp.draw<WHITE, false>(bird_x, bird_y);
       }
 
     }
     else {
 
       // bird is currently falling, use wing up frame
-      display.drawBitmap(bird_x, bird_y, wing_up_bmp, 16, 16, WHITE);
+      wingUp.draw<WHITE, false>(bird_x, bird_y);
 
     }
 
@@ -78,10 +153,10 @@ void flappyLoop() {
     for (int i = 0 ; i < 2; i++) {
 
       // draw the top half of the wall
-      display.fillRect(wall_x[i], 0, wall_width, wall_y[i], WHITE);
+      fillBar<WHITE, true>(wall_x[i], 0, wall_width, wall_y[i]);
 
       // draw the bottom half of the wall
-      display.fillRect(wall_x[i], wall_y[i] + wall_gap, wall_width, display.height() - wall_y[i] + wall_gap, WHITE);
+      fillBar<WHITE, true>(wall_x[i], wall_y[i] + wall_gap, wall_width, display.height() - wall_y[i] - wall_gap);
 
       // if the wall has hit the edge of the screen
       // reset it back to the other side with a new gap position
@@ -106,11 +181,12 @@ void flappyLoop() {
       ) {
         
         // display the crash and pause 1/2 a second
-        display.display();
+        flushDisplay();
         delay(500);
 
         // switch to game over state
         game_state = 1; 
+        telemetryLog(LOG_GAME_OVER, score);
 
       }
 
@@ -123,7 +199,7 @@ void flappyLoop() {
 
     // now display everything to the user and wait a bit to keep things playable
     // display.display();
-    delay(GAME_SPEED);
+    animHold(GAME_SPEED);
   }
   else {
     EEPROM.get(0, high_score);
@@ -133,7 +209,7 @@ void flappyLoop() {
       EEPROM.commit();
     }
 
-    outlineTextAtCenter(1, "Flappy MaoMao");
+    outlineTextAtCenter(1, tilt_control ? "Tilty MaoMao" : "Flappy MaoMao");
     
     textAtCenter(display.height() / 2 - 8, "Tap to start");
     textAtCenter(display.height() / 2, "Hold to exit");
@@ -150,25 +226,9 @@ void flappyLoop() {
     wall_x[1] = display.width() + display.width() / 2;
     wall_y[1] = display.height() / 2 - wall_gap / 1;
     score = 0;
-  }
-
-}
-
-/**
- * clear the screen using a wipe down animation
- */
-void screenWipe(int speed) {
-
-  // progressivly fill screen with white
-  for (int i = 0; i < display.height(); i += speed) {
-    display.fillRect(0, i, display.width(), speed, WHITE);
-    display.display();
-  }
-
-  // progressively fill the screen with black
-  for (int i = 0; i < display.height(); i += speed) {
-    display.fillRect(0, i, display.width(), speed, BLACK);
-    display.display();
+    tiltFraction = 0;
+    tiltBackoff = 0;
+    tiltReset();
   }
 
 }
@@ -188,31 +248,73 @@ void textAtCenter(int y, String txt) {
   textAt(display.width() / 2 - txt.length() * 3, y, txt);
 }
 
+enum TextStyle { TEXT_BOLD, TEXT_OUTLINE };
+
+// the text run plus a blank column each side and the pixel after a bold run
+#define TEXT_COLUMNS (SCREEN_WIDTH + 3)
+
 /**
- * displays outlined text centered on the line
+ * ORs set into and then clears clear out of the column x, bit 0 at row top
  */
-void outlineTextAtCenter(int y, String txt) {
+static void paintColumn(int16_t x, int16_t top, uint16_t set, uint16_t clear) {
+  if (x < 0 || x >= SCREEN_WIDTH || !(set | clear)) {
+    return;
+  }
+  uint32_t on = (uint32_t)set << (top & 7);
+  uint32_t off = (uint32_t)clear << (top & 7);
+  int8_t page = top >> 3;
+  uint8_t *b = display.getBuffer() + page * SCREEN_WIDTH + x;
+  for (uint8_t p = 0; p < 3; p++, page++, b += SCREEN_WIDTH, on >>= 8, off >>= 8) {
+    if (page >= 0 && page < SCREEN_PAGES) {
+      *b = (*b | on) & ~off;
+    }
+  }
+}
+
+/**
+ * centered text drawn like several offset print() passes would, from one
+ * pass over the glyphs. The run goes into a strip of 16-bit columns with
+ * the glyph rows in bits 1..8, so the neighbours of a pixel are one column
+ * or one bit away and bold and outline come out of ORs and shifts.
+ */
+static void styledTextAtCenter(int y, const String &txt, TextStyle style) {
   int x = display.width() / 2 - txt.length() * 3;
+  uint16_t strip[TEXT_COLUMNS + 1] = {};  // column i is screen column x - 1 + i
 
-  display.setTextColor(WHITE);
-  textAt(x - 1, y, txt);
-  textAt(x + 1, y, txt);
-  textAt(x, y - 1, txt);
-  textAt(x, y + 1, txt);
+  for (unsigned int i = 0; i < txt.length() && 6 * i + 6 < TEXT_COLUMNS; i++) {
+    uint8_t c = txt[i];
+    if (c >= 176) {
+      c++;  // what print() does without cp437()
+    }
+    for (uint8_t k = 0; k < 5; k++) {
+      strip[1 + 6 * i + k] = pgm_read_byte(&font[c * 5 + k]) << 1;
+    }
+  }
 
-  display.setTextColor(BLACK);
-  textAt(x, y, txt);
-  display.setTextColor(WHITE);
+  for (uint8_t i = 0; i < TEXT_COLUMNS; i++) {
+    uint16_t left = i ? strip[i - 1] : 0;
+    uint16_t glyph = strip[i];
+    if (style == TEXT_BOLD) {
+      // the run printed at x and at x + 1
+      paintColumn(x - 1 + i, y - 1, glyph | left, 0);
+    } else {
+      // white at x - 1, x + 1, y - 1 and y + 1, then the glyph in black
+      paintColumn(x - 1 + i, y - 1, left | strip[i + 1] | glyph << 1 | glyph >> 1, glyph);
+    }
+  }
+}
 
+/**
+ * displays outlined text centered on the line
+ */
+void outlineTextAtCenter(int y, String txt) {
+  styledTextAtCenter(y, txt, TEXT_OUTLINE);
+  display.setTextColor(WHITE);
 }
 
 /**
  * displays bold text centered on the line
  */
 void boldTextAtCenter(int y, String txt) {
-  int x = display.width() / 2 - txt.length() * 3;
-
-  textAt(x, y, txt);
-  textAt(x + 1, y, txt);
-
+  styledTextAtCenter(y, txt, TEXT_BOLD);
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
+#include "framebuffer.h"
+#include "arena.h"
 /**
    Nano Bird - a flappy bird clone for arduino nano, oled screen & push on switch
 
@@ -10,12 +10,12 @@
    @author  Richard Allsebrook <richardathome@gmail.com>
 */
 
-extern Adafruit_SSD1306 display;
-
 // Initialise 'sprites'
 #define SPRITE_HEIGHT   16
 #define SPRITE_WIDTH    16
 
+#define FLAPPY_WIPE_TIME 300  // ms, the game over screen wiped away by a new game
+
 // Two frames of animation
 static const unsigned char PROGMEM wing_down_bmp[] =
 { B00000000, B00000000,
@@ -55,8 +55,40 @@ static const unsigned char PROGMEM wing_up_bmp[] =
   B00000000, B00000000,
 };
 
+/**
+ * the game's working state, it lives in the mode arena (arena.h) while the
+ * flappy menu is up
+ */
+struct FlappyGame {
+  int game_state = 1; // 0 = game over screen, 1 = in game
+  int score = 0; // current game score
+  int high_score = 0; // highest score since the nano was reset
+  int bird_x = SCREEN_WIDTH / 4; // birds x position (along) - initialised to 1/4 the way along the screen
+  int bird_y = 0; // birds y position (down)
+  int momentum = 0; // how much force is pulling the bird down
+  int wall_x[2] = {}; // an array to hold the walls x positions
+  int wall_y[2] = {}; // an array to hold the walls y positions
+  int wall_gap = 30; // size of the wall wall_gap in pixels
+  int wall_width = 10; // width of the wall in pixels
+  int16_t tiltFraction = 0; // position below a pixel, tilt control
+  uint8_t tiltBackoff = 0; // frames left without sampling
+
+  void loop();
+  void sampleTilt();
+  void tiltSteer();
+};
+
+extern bool tilt_control;
+
+/**
+ * the running game, nullptr outside the flappy menu
+ */
+static inline __attribute__((always_inline)) FlappyGame *flappyGame() {
+  return arenaState<FlappyGame>(ARENA_FLAPPY);
+}
+
+void flappyEnter();
 void flappyLoop();
-void screenWipe(int speed);
 void textAt(int x, int y, String txt);
 void textAtCenter(int y, String txt);
 void outlineTextAtCenter(int y, String txt);
@@ -0,0 +1,93 @@
+#include "framebuffer.h"
+
+FrameBuffer display;
+
+static inline void paint(uint8_t *b, uint8_t mask, uint16_t color) {
+  switch (color) {
+    case WHITE: *b |= mask; break;
+    case BLACK: *b &= ~mask; break;
+    case INVERSE: *b ^= mask; break;
+  }
+}
+
+/**
+ * starts the panel and blanks it, false when the panel is missing
+ */
+bool FrameBuffer::begin() {
+  if (!panel.begin()) {
+    return false;
+  }
+  clearDisplay();
+  display();
+  return true;
+}
+
+bool FrameBuffer::getPixel(int16_t x, int16_t y) {
+  if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) {
+    return false;
+  }
+  return buffer[(y / 8) * SCREEN_WIDTH + x] & (1 << (y & 7));
+}
+
+void FrameBuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) {
+    return;
+  }
+  paint(&buffer[(y / 8) * SCREEN_WIDTH + x], 1 << (y & 7), color);
+}
+
+/**
+ * same bit in a run of bytes of one page
+ */
+void FrameBuffer::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (y < 0 || y >= SCREEN_HEIGHT) {
+    return;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (x + w > SCREEN_WIDTH) {
+    w = SCREEN_WIDTH - x;
+  }
+  uint8_t *b = &buffer[(y / 8) * SCREEN_WIDTH + x];
+  uint8_t mask = 1 << (y & 7);
+  while (w-- > 0) {
+    paint(b++, mask, color);
+  }
+}
+
+/**
+ * one masked byte per page the line crosses, fillRect() ends up here
+ */
+void FrameBuffer::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (x < 0 || x >= SCREEN_WIDTH) {
+    return;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (y + h > SCREEN_HEIGHT) {
+    h = SCREEN_HEIGHT - y;
+  }
+  int16_t bottom = y + h;
+  uint8_t *b = &buffer[(y / 8) * SCREEN_WIDTH + x];
+  while (y < bottom) {
+    uint8_t shift = y & 7;
+    uint8_t rows = min(8 - shift, bottom - y);
+    paint(b, (0xFF >> (8 - rows)) << shift, color);
+    b += SCREEN_WIDTH;
+    y += rows;
+  }
+}
+
+void FrameBuffer::fillScreen(uint16_t color) {
+  if (color == INVERSE) {
+    for (uint16_t i = 0; i < sizeof(buffer); i++) {
+      buffer[i] = ~buffer[i];
+    }
+  } else {
+    memset(buffer, color == WHITE ? 0xFF : 0x00, sizeof(buffer));
+  }
+}
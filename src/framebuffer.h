@@ -0,0 +1,44 @@
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "panel.h"
+
+/**
+   The Adafruit_GFX canvas everything draws on. The buffer is page-major like
+   the SSD1306 RAM: one byte is 8 vertical pixels, LSB on top, a page row of
+   SCREEN_WIDTH bytes per 8 lines. display() hands it to the panel driver,
+   display(first, last) only sends the given pages.
+
+   The geometry is fixed at compile time (SCREEN_WIDTH/SCREEN_HEIGHT in
+   panel.h), so the pixel code works on constants instead of GFX's sizes.
+*/
+
+#define BLACK 0
+#define WHITE 1
+#define INVERSE 2
+
+class FrameBuffer : public Adafruit_GFX {
+ public:
+  FrameBuffer() : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT) {}
+
+  bool begin();
+  void clearDisplay() { memset(buffer, 0, sizeof(buffer)); }
+  void display() { panel.flush(buffer); }
+  void display(uint8_t firstPage, uint8_t lastPage) { panel.flush(buffer, firstPage, lastPage, 0, SCREEN_WIDTH - 1); }
+  void display(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+    panel.flush(buffer, firstPage, lastPage, firstColumn, lastColumn);
+  }
+  void invertDisplay(bool on) { panel.command(on ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY); }
+  uint8_t *getBuffer() { return buffer; }
+  bool getPixel(int16_t x, int16_t y);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+
+ private:
+  uint8_t buffer[SCREEN_WIDTH * SCREEN_PAGES] __attribute__((aligned(4)));
+};
+
+extern FrameBuffer display;
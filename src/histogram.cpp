@@ -0,0 +1,55 @@
+#include "histogram.h"
+
+void histogramReset(Histogram &h) {
+  memset(&h, 0, sizeof(h));
+}
+
+/**
+ * lower edge of a bucket, inverse of histogramBucket()
+ */
+static uint32_t bucketFloor(uint8_t b) {
+  if (b < 16) {
+    return b;
+  }
+  uint8_t octave = 4 + (b - 16) / 4;
+  return (4UL + (b & 3)) << (octave - 2);
+}
+
+/**
+ * upper bound of the bucket holding the given percentile, clamped to the real max
+ */
+uint32_t histogramPercentile(const Histogram &h, uint8_t percent) {
+  if (h.count == 0) {
+    return 0;
+  }
+
+  uint32_t rank = (uint64_t)h.count * percent / 100;
+  uint32_t seen = 0;
+  for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+    seen += h.buckets[b];
+    if (seen > rank) {
+      if (b == HISTOGRAM_BUCKETS - 1) {
+        return h.max;
+      }
+      return min(bucketFloor(b + 1) - 1, h.max);
+    }
+  }
+  return h.max;
+}
+
+void histogramPrint(Print &out, const char *name, const Histogram &h) {
+  out.print(name);
+  out.print(" n=");
+  out.print(h.count);
+  out.print(" min=");
+  out.print(h.count ? h.min : 0);
+  out.print(" avg=");
+  out.print(h.count ? h.sum / h.count : 0);
+  out.print(" p50=");
+  out.print(histogramPercentile(h, 50));
+  out.print(" p99=");
+  out.print(histogramPercentile(h, 99));
+  out.print(" max=");
+  out.print(h.max);
+  out.println(" us");
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Fixed-size log-linear histogram for durations in microseconds.
+
+   Values below 16 us get a bucket each, above that every power of two is split
+   into 4 sub-buckets (~12% resolution). Anything past 8 s lands in the last
+   bucket, the exact maximum is tracked separately.
+*/
+
+#define HISTOGRAM_BUCKETS 92
+
+struct Histogram {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint32_t sum;
+  uint32_t buckets[HISTOGRAM_BUCKETS];
+};
+
+static inline uint8_t histogramBucket(uint32_t v) {
+  if (v < 16) {
+    return v;
+  }
+  uint8_t octave = 31 - __builtin_clz(v);
+  if (octave > 22) {
+    return HISTOGRAM_BUCKETS - 1;
+  }
+  return 16 + (octave - 4) * 4 + ((v >> (octave - 2)) & 3);
+}
+
+static inline void histogramRecord(Histogram &h, uint32_t v) {
+  if (h.count == 0 || v < h.min) {
+    h.min = v;
+  }
+  if (v > h.max) {
+    h.max = v;
+  }
+  h.count++;
+  h.sum += v;
+  h.buckets[histogramBucket(v)]++;
+}
+
+void histogramReset(Histogram &h);
+uint32_t histogramPercentile(const Histogram &h, uint8_t percent);
+void histogramPrint(Print &out, const char *name, const Histogram &h);
@@ -0,0 +1,73 @@
+#include "latency.h"
+
+#ifdef MAO_LATENCY
+
+#include "histogram.h"
+
+static Histogram latencies[GESTURE_COUNT];
+
+// Per gesture, the edge time of the oldest press not shown yet
+static volatile uint32_t pendingEdge[GESTURE_COUNT];
+static volatile uint8_t pendingMask = 0;
+static uint8_t appliedMask = 0;
+
+static const char *const gestureNames[GESTURE_COUNT] = {
+  "flap", "once", "twice", "hold"
+};
+
+/**
+ * an input was acted upon, the next frame that starts rendering reflects it.
+ * also called from IRQHandler() for flaps
+ */
+void IRAM_ATTR latencyPending(LatencyGesture gesture, uint32_t edgeMicros) {
+  uint8_t bit = 1 << gesture;
+  if (!(pendingMask & bit)) {
+    pendingEdge[gesture] = edgeMicros;
+    pendingMask |= bit;
+  }
+}
+
+/**
+ * a frame starts rendering, everything pending so far ends up in it
+ */
+void latencyFrameBegin() {
+  noInterrupts();
+  appliedMask |= pendingMask;
+  interrupts();
+}
+
+/**
+ * a flush finished, the applied inputs are on the panel now
+ */
+void latencyFlushed(uint32_t nowMicros) {
+  if (!appliedMask) {
+    return;
+  }
+
+  noInterrupts();
+  uint8_t done = appliedMask;
+  pendingMask &= ~done;
+  appliedMask = 0;
+  interrupts();
+
+  for (uint8_t g = 0; g < GESTURE_COUNT; g++) {
+    if (done & (1 << g)) {
+      histogramRecord(latencies[g], nowMicros - pendingEdge[g]);
+    }
+  }
+}
+
+void latencyReset() {
+  for (uint8_t g = 0; g < GESTURE_COUNT; g++) {
+    histogramReset(latencies[g]);
+  }
+}
+
+void latencyDump(Print &out) {
+  out.println("input to photon latency");
+  for (uint8_t g = 0; g < GESTURE_COUNT; g++) {
+    histogramPrint(out, gestureNames[g], latencies[g]);
+  }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Input-to-photon latency probe.
+
+   Build with -DMAO_LATENCY (the d1_mini_latency env). Each D5 press is timestamped
+   in the interrupt, the press becomes pending when the code acts on it, applied
+   once a frame starts rendering with it, and measured at the end of the flush
+   that carries that frame. 'l' over Serial dumps the distribution per gesture,
+   'L' resets it.
+
+   Timestamps are passed in by the caller (micros()), so the bookkeeping does not
+   depend on the hardware.
+*/
+
+enum LatencyGesture : uint8_t {
+  GESTURE_FLAP,   // tap in game, IRQHandler() sets the momentum
+  GESTURE_ONCE,   // single tap, starts flappy from the game over screen
+  GESTURE_TWICE,  // double tap, petting or memes
+  GESTURE_HOLD,   // hold, next menu
+  GESTURE_COUNT
+};
+
+#ifdef MAO_LATENCY
+
+void latencyPending(LatencyGesture gesture, uint32_t edgeMicros);
+void latencyFrameBegin();
+void latencyFlushed(uint32_t nowMicros);
+void latencyReset();
+void latencyDump(Print &out);
+
+#else
+
+static inline void latencyPending(LatencyGesture, uint32_t) {}
+static inline void latencyFrameBegin() {}
+static inline void latencyFlushed(uint32_t) {}
+static inline void latencyReset() {}
+static inline void latencyDump(Print &) {}
+
+#endif
@@ -1,21 +1,26 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
 #include <EEPROM.h>
-#include "sleep.h"
-#include "blink.h"
-#include "pet.h"
-#include "maotek.h"
-#include "randoms.h"
-#include "dizzy.h"
-#include "sideeyes.h"
-#include "study.h"
-#include "memes.h"
 #include "flappy.h"
+#include "assets.h"
+#include "blit.h"
+#include "framebuffer.h"
+#include "pins.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "render.h"
+#include "latency.h"
+#include "replay.h"
+#include "autopilot.h"
+#include "effects.h"
+#include "power.h"
+#include "anim.h"
+#include "transition.h"
+#include "eyes.h"
 
 #define MENU_BLINK 0
 #define MENU_STUDY 2
@@ -31,24 +36,28 @@
 #define MODE_STUDY 5
 #define MODE_MEMES 6
 #define MODE_FLAPPY 7
+#define MODE_SPLASH 8
+#define MODE_EYES 9
 
-Adafruit_SSD1306 display(128, 64, &Wire, -1);
 Adafruit_MPU6050 mpu;
 
-extern int momentum;
-extern int game_state;
-
 // Forward declaration
-void changeMode(byte newMode, uint16_t expireTime, byte maxFrames);
+void changeMode(byte newMode, uint16_t expireTime, byte maxFrames, TransitionKind transition = TRANSITION_NONE);
 void delayFrame(uint16_t delay);
+bool holdFrame(byte frame);
+void skipLateFrames();
+void applyModeSettings();
+void idleSleep();
+bool moved(const sensors_vec_t &from, const sensors_vec_t &to);
+bool streamable();
 
 // For the game
-void screenWipe(int speed);
 void textAt(int x, int y, String txt);
 void textAtCenter(int y, String txt);
 void outlineTextAtCenter(int y, String txt);
 void boldTextAtCenter(int y, String txt);
 void flappyLoop();
+void serialCommands();
 
 
 // Constants
@@ -58,6 +67,7 @@ void flappyLoop();
 #define PETTING_TIMER 2500
 #define DIZZY_TIMER 3000
 #define MEMES_TIMER 2000
+#define SPLASH_TIMER 3000
 
 
 volatile byte mode = MODE_BLINK;
@@ -67,30 +77,35 @@ volatile byte menu = 0;
 volatile byte buttonPressed = 0;        // is the button pressed?
 volatile byte buttonPressedAmount = 0;  // amount of presses
 long firstButtonPressedTime = 0;        // time the first button was pressed, to detect multiple presses
-
-uint16_t frameDelay = 0;
-unsigned long framePausedTime;
+unsigned long firstButtonPressedMicros; // same in micros, for the latency probe
 
 byte frameDirection = 0;
-byte maxFrameCount = BLINK_FRAMES;
-byte curFrameCount = BLINK_FRAMES / 2;  // start at eyes closed
+byte maxFrameCount = assetFrames(CLIP_BLINK);
+byte curFrameCount = assetFrames(CLIP_BLINK) / 2;  // start at eyes closed
 
 unsigned long timerStartTime;
 unsigned long timer;
 
 unsigned long mpuPrevTime;  // Previous time for MPU scheduling
+sensors_vec_t mpuPrevAccel; // Previous sample, to notice motion
 
 byte randomSideEye;
 
 byte randomMeme;
 
-void IRAM_ATTR IRQHandler() {
-  if (digitalRead(D5)) {
+bool mpuReady;               // false when the MPU did not answer at boot
+bool firstFrameShown = false;
 
-    if(menu == MENU_FLAPPY) {
+void IRAM_ATTR buttonEdge(byte level) {
+  powerActivity();
+  if (level) {
+
+    FlappyGame *game = flappyGame();
+    if(game) {
       // If we are in the flappy menu, and the game started, we want to act immediately after user presses button
-      if(game_state == 0){
-        momentum = -4;
+      if(game->game_state == 0){
+        game->momentum = -4;
+        latencyPending(GESTURE_FLAP, micros());
       }
       
     }
@@ -98,6 +113,7 @@ void IRAM_ATTR IRQHandler() {
     buttonPressed = 1;
     if (buttonPressedAmount == 0) {
       firstButtonPressedTime = millis();
+      firstButtonPressedMicros = micros();
     }
     buttonPressedAmount++;
   } else {
@@ -105,53 +121,125 @@ void IRAM_ATTR IRQHandler() {
   }
 }
 
+void IRAM_ATTR IRQHandler() {
+  byte level = digitalRead(TOUCH_PIN);
+  TRACE_BEGIN(TRACE_IRQ, level);
+  replayEdge(level);
+  buttonEdge(level);
+  TRACE_END(TRACE_IRQ, 0);
+}
+
 void setup() {
-  Serial.begin(9600);
+  telemetryBegin();
+  powerBegin();
+  animBegin();
+
+  // Setup oled first, the splash is up while everything else initialises
+  if (!display.begin()) {
+    telemetryLog(LOG_BOOT_FAILED, 0);
+    telemetryFlush();
+    for (;;)
+      ;
+  }
+
+  // Display informatics
+  display.clearDisplay();
+  assetDraw(CLIP_SPLASH, 0);
+  flushDisplay();
+  telemetryLog(LOG_BOOT_SPLASH, millis());
+
+  // Asset pack on LittleFS, clips it does not have stay on the built-in frames
+  assetsBegin();
 
   // Setup EEPROM
   EEPROM.begin(4);
 
-  // Random number generator
-  randomSeed(analogRead(A0));
+  // Recorded inputs are timed from here, before the first edge can come in
+  replayBegin(buttonEdge);
 
-  // Touch interrupt handler
-  attachInterrupt(digitalPinToInterrupt(D5), IRQHandler, CHANGE);
+  // Random number generator
+  randomSeed(replaySeed(analogRead(A0)));
 
-  // Setup oled
-  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-    for (;;)
-      ;
+  // Touch interrupt handler, a replay feeds the edges itself
+  // an SPI panel shares the pin with MISO, take it back
+  pinMode(TOUCH_PIN, INPUT);
+  if (!REPLAYING) {
+    attachInterrupt(digitalPinToInterrupt(TOUCH_PIN), IRQHandler, CHANGE);
   }
 
-  // Setup MPU
-  if (!mpu.begin()) {
-    for (;;)
-      ;
+  // Setup MPU, without it the toy still runs, just without motion
+  mpuReady = mpu.begin();
+  if (mpuReady) {
+    mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
+  } else {
+    telemetryLog(LOG_BOOT_FAILED, 1);
+    display.fillRect(0, display.height() - 8, display.width(), 8, BLACK);
+    textAtCenter(display.height() - 8, "no motion sensor");
+    flushDisplay();
   }
-  mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
 
-  // Display informatics
-  display.clearDisplay();
-  display.clearDisplay();
-  display.drawBitmap(0, 0, maotek, 128, 64, WHITE);
-  display.display();
-  delay(3000);
+  // The splash stays up on its own timer, any gesture skips it
+  changeMode(MODE_SPLASH, SPLASH_TIMER, 1);
+  delayFrame(SPLASH_TIMER);
+
+  // Soak tests go straight into the game
+  if (AUTOPILOT) {
+    menu = MENU_FLAPPY;
+    changeMode(MODE_FLAPPY, 0, 1);
+  }
 }
 
 void loop() {
 
-  if (!frameDelay) {
-    display.clearDisplay();
+  serialCommands();
+  telemetryDrain();
+  fxUpdate();
+  transitionUpdate();
+
+  // A meme scrolls once the dissolve has brought it all in, the frame itself
+  // is only drawn once so this cannot wait for the next one
+  if (mode == MODE_MEMES && !fxScrolling() && !transitionActive()) {
+    fxScroll(FX_SCROLL_LEFT, FX_SPEED_2);
+  }
+
+  // Nobody touched or moved the toy for a while, sleep until that changes
+  if (powerUpdate(menu == MENU_SLEEP)) {
+    applyModeSettings();  // the sleep mode breathes again
+  }
+  if (!REPLAYING && !AUTOPILOT && powerIdle(menu == MENU_SLEEP)) {
+    idleSleep();
+  }
+
+  if (animDue()) {
+    if (animPeriod()) {
+      TRACE_END(TRACE_PAUSE, animPeriod());
+    }
+    animBeginFrame();
+    skipLateFrames();
+
+    PROFILE_BEGIN(STAGE_FRAME);
+    TRACE_BEGIN(TRACE_FRAME, mode);
+    latencyFrameBegin();
+    bool direct = streamable();
+    assetsStream(direct);
+    transitionBeginFrame();
+    PROFILE_BEGIN(STAGE_CLEAR);
+    if (!direct && mode != MODE_EYES) {  // the eyes keep their whites and only move the pupils
+      display.clearDisplay();
+    }
+    PROFILE_END(STAGE_CLEAR);
+    bool fullFrame = true;  // false when the mode sent its own windows
+    PROFILE_BEGIN(STAGE_DRAW);
 
     if (mode == MODE_BLINK) {
-      display.drawBitmap(0, 0, blink[curFrameCount], 128, 64, WHITE);
+      assetDraw(CLIP_BLINK, curFrameCount);
 
       // Introduce custom delays
       if (curFrameCount == 0) {
         delayFrame(random(2000, 4000));
         if (random(0, 8) == 0) {
-          changeMode(MODE_SIDEEYE, 0, SIDEEYE_FRAMES);
           randomSideEye = random(0, 2);
+          changeMode(MODE_SIDEEYE, 0, assetFrames((AssetClip)(CLIP_SIDEEYE_0 + randomSideEye)));
         }
 
       } else if (curFrameCount == maxFrameCount / 2) {
@@ -159,61 +247,100 @@ void loop() {
       }
 
     } else if (mode == MODE_SIDEEYE) {
-      display.drawBitmap(0, 0, sideEyes[randomSideEye][curFrameCount], 128, 64, WHITE);
+      assetDraw((AssetClip)(CLIP_SIDEEYE_0 + randomSideEye), curFrameCount);
       delayFrame(50);
 
       if (curFrameCount == maxFrameCount - 1) {  // return to main mode
-        changeMode(MODE_BLINK, 0, BLINK_FRAMES);
+        changeMode(MODE_BLINK, 0, assetFrames(CLIP_BLINK));
       } else if (curFrameCount == maxFrameCount / 2) {  // stop during middle
         delayFrame(random(1000, 2000));
       }
     }
 
     else if (mode == MODE_PETTING) {
-      display.drawBitmap(0, 0, petting[curFrameCount], 128, 64, WHITE);
+      assetDraw(CLIP_PETTING, curFrameCount);
       delayFrame(100);
     } else if (mode == MODE_DIZZY) {
-      display.drawBitmap(0, 0, dizzy[curFrameCount], 128, 64, WHITE);
+      assetDraw(CLIP_DIZZY, curFrameCount);
       delayFrame(50);
     } else if (mode == MODE_SLEEP) {
-      display.drawBitmap(0, 0, sleep[curFrameCount], 128, 64, WHITE);
+      assetDraw(CLIP_SLEEP, curFrameCount);
       delayFrame(300);
     } else if (mode == MODE_STUDY) {
-      display.drawBitmap(0, 0, study[curFrameCount], 128, 64, WHITE);
+      assetDraw(CLIP_STUDY, curFrameCount);
       delayFrame(500);
+    } else if (mode == MODE_SPLASH) {
+      assetDraw(CLIP_SPLASH, 0);
+      delayFrame(SPLASH_TIMER);
     } else if (mode == MODE_MEMES) {
-      display.drawBitmap(0, 0, memes[randomMeme], 128, 64, WHITE);
-    } else if (mode == MODE_FLAPPY) {
+      assetDraw(CLIP_MEMES, randomMeme);
+      delayFrame(MEMES_TIMER);  // the controller scrolls it, no need to redraw
+    } else if (mode == MODE_EYES) {
+      fullFrame = eyesFrame();
+      delayFrame(EYES_PERIOD);
+    }
+    PROFILE_END(STAGE_DRAW);
+
+    if (mode == MODE_FLAPPY) {
+      if (AUTOPILOT) {
+        autopilotFrame();
+      }
+      PROFILE_BEGIN(STAGE_FLAPPY);
       flappyLoop();
+      PROFILE_END(STAGE_FLAPPY);
     }
 
-    display.display();
-    curFrameCount = ++curFrameCount % maxFrameCount;
-  }
+    PROFILE_BEGIN(STAGE_FLUSH);
+    if (direct) {
+      assetsFlush();
+    } else if (fullFrame) {
+      transitionFlush();
+    }
+    PROFILE_END(STAGE_FLUSH);
+    TRACE_END(TRACE_FRAME, mode);
+    PROFILE_END(STAGE_FRAME);
 
+    // decode the next frame of a pack clip while this one is up
+    assetsPrefetch();
 
-  // When to stop delays inbetween frames
-  if (millis() - framePausedTime > frameDelay) {
-    frameDelay = 0;
+    if (!firstFrameShown && mode != MODE_SPLASH) {
+      firstFrameShown = true;
+      telemetryLog(LOG_FIRST_FRAME, millis());
+    }
+    curFrameCount = ++curFrameCount % maxFrameCount;
   }
 
+
   // When to stop the different modes
   if (timer && millis() - timerStartTime > timer) {
     if (menu == MENU_BLINK) {
-      changeMode(MODE_BLINK, 0, BLINK_FRAMES);  // Set current frame to random frame
+      // Set current frame to random frame
+      changeMode(MODE_BLINK, 0, assetFrames(CLIP_BLINK), mode == MODE_SPLASH ? TRANSITION_IRIS : TRANSITION_DISSOLVE);
     } else if (menu == MENU_STUDY) {
-      changeMode(MODE_STUDY, 0, STUDY_FRAMES);
+      changeMode(MODE_STUDY, 0, assetFrames(CLIP_STUDY), TRANSITION_DISSOLVE);
     }
   }
 
   // poll the MPU
-  if (millis() - mpuPrevTime > MPU_POLLING_INTERVAL) {
+  if (mpuReady && millis() - mpuPrevTime > MPU_POLLING_INTERVAL) {
     sensors_event_t a, g, temp;
+    PROFILE_BEGIN(STAGE_MPU);
+    TRACE_BEGIN(TRACE_MPU, 0);
     mpu.getEvent(&a, &g, &temp);
+    TRACE_END(TRACE_MPU, 0);
+    PROFILE_END(STAGE_MPU);
+    replayMpu(a.acceleration);
+
+    if (moved(mpuPrevAccel, a.acceleration)) {
+      powerActivity();
+    }
+    mpuPrevAccel = a.acceleration;
 
     if (abs(a.acceleration.x) > SHAKE_THRESHOLD || abs(a.acceleration.y) > SHAKE_THRESHOLD || abs(a.acceleration.z - 9.8) > SHAKE_THRESHOLD) {
-      if (menu == 0) {
-        changeMode(MODE_DIZZY, DIZZY_TIMER, DIZZY_FRAMES);
+      telemetryLog(LOG_SHAKE);
+      // tilting the toy around is the point of the eyes
+      if (menu == 0 && mode != MODE_EYES) {
+        changeMode(MODE_DIZZY, DIZZY_TIMER, assetFrames(CLIP_DIZZY), TRANSITION_DISSOLVE);
       }
     }
 
@@ -222,73 +349,232 @@ void loop() {
 
   // Process buttons
   if (firstButtonPressedTime != 0 && millis() - firstButtonPressedTime > BUTTON_DELAY) {
-
+    PROFILE_BEGIN(STAGE_BUTTONS);
+    TRACE_BEGIN(TRACE_BUTTONS, buttonPressedAmount);
+    FlappyGame *game = flappyGame();
+
+    // Any gesture skips the splash
+    if (mode == MODE_SPLASH) {
+      changeMode(MODE_BLINK, 0, assetFrames(CLIP_BLINK), TRANSITION_IRIS);
+      buttonPressedAmount = 0;
+    }
 
     if (buttonPressedAmount == 3) {
-      Serial.println("Pressed thrice");
+      telemetryLog(LOG_PRESSED_THRICE);
+
+      if (menu == MENU_BLINK && mode == MODE_EYES) {
+        changeMode(MODE_BLINK, 0, assetFrames(CLIP_BLINK), TRANSITION_DISSOLVE);
+      } else if (menu == MENU_BLINK && mpuReady) {
+        changeMode(MODE_EYES, 0, 1, TRANSITION_DISSOLVE);
+      } else if (menu == MENU_FLAPPY && game->game_state == 1 && mpuReady && !AUTOPILOT) {
+        tilt_control = !tilt_control;
+      }
     }
     if (buttonPressedAmount == 2) {  // Pressed twice
-      Serial.println("Pressed twice");
+      telemetryLog(LOG_PRESSED_TWICE);
 
       if (menu == MENU_BLINK) {
-        changeMode(MODE_PETTING, PETTING_TIMER, PET_FRAMES);
+        changeMode(MODE_PETTING, PETTING_TIMER, assetFrames(CLIP_PETTING), TRANSITION_DISSOLVE);
+        latencyPending(GESTURE_TWICE, firstButtonPressedMicros);
       } else if (menu == MENU_STUDY) {
-        randomMeme = random(0, MEMESLEN);
-        changeMode(MODE_MEMES, MEMES_TIMER, 1);
+        randomMeme = random(0, assetFrames(CLIP_MEMES));
+        changeMode(MODE_MEMES, MEMES_TIMER, 1, TRANSITION_DISSOLVE);
+        latencyPending(GESTURE_TWICE, firstButtonPressedMicros);
       }
 
     } else if (buttonPressedAmount == 1 && buttonPressed) {  // Hold button
-      Serial.println("Pressed hold");
+      telemetryLog(LOG_PRESSED_HOLD);
+      byte previousMenu = menu;
 
       if (menu == MENU_BLINK) {
         menu = MENU_SLEEP;
         mode = MODE_SLEEP;
-        maxFrameCount = SLEEP_FRAMES;
+        maxFrameCount = assetFrames(CLIP_SLEEP);
         curFrameCount = random(0, maxFrameCount);
-        frameDelay = 0;
+        animReset();
       } else if (menu == MENU_SLEEP) {
         menu = MENU_STUDY;
         mode = MODE_STUDY;
-        maxFrameCount = STUDY_FRAMES;
+        maxFrameCount = assetFrames(CLIP_STUDY);
         curFrameCount = random(0, maxFrameCount);
-        frameDelay = 0;
+        animReset();
       } else if (menu == MENU_STUDY) {
         menu = MENU_FLAPPY;
         mode = MODE_FLAPPY;
         maxFrameCount = 1;
         curFrameCount = 0;
-        frameDelay = 0;
-      } else if (menu == MENU_FLAPPY && game_state == 1) { // we should not be ingame when we want to change
+        animReset();
+      } else if (menu == MENU_FLAPPY && game->game_state == 1) { // we should not be ingame when we want to change
         menu = MENU_BLINK;
         mode = MODE_BLINK;
-        maxFrameCount = BLINK_FRAMES;
+        maxFrameCount = assetFrames(CLIP_BLINK);
         curFrameCount = random(0, maxFrameCount);
-        frameDelay = 0;
+        animReset();
+      }
+      if (menu != previousMenu) {  // a hold in a running game changes nothing
+        transitionStart(TRANSITION_SLIDE, TRANSITION_TIME);
+        telemetryLog(LOG_MENU, menu);
+        TRACE_BEGIN(TRACE_MODE, mode);
+        latencyPending(GESTURE_HOLD, firstButtonPressedMicros);
+        applyModeSettings();
       }
     } else if (buttonPressedAmount == 1) {  // Pressed once
-      Serial.println("Pressed once");
-      if (game_state == 1 && mode == MODE_FLAPPY) {
-        screenWipe(10);
-        game_state = 0;
+      telemetryLog(LOG_PRESSED_ONCE);
+      if (mode == MODE_FLAPPY && game->game_state == 1) {
+        latencyPending(GESTURE_ONCE, firstButtonPressedMicros);
+        transitionStart(TRANSITION_WIPE, FLAPPY_WIPE_TIME);
+        game->game_state = 0;
       }
     }
 
     buttonPressed = 0;
     firstButtonPressedTime = 0;
     buttonPressedAmount = 0;
+    TRACE_END(TRACE_BUTTONS, 0);
+    PROFILE_END(STAGE_BUTTONS);
   }
+
+  // Nothing to draw yet, idle until the frame tick
+  animIdle();
 }
 
-void changeMode(byte newMode, uint16_t expireTime, byte maxFrames) {
+// Single character commands over Serial, used for on-device diagnostics
+void serialCommands() {
+  while (Serial.available()) {
+    switch (Serial.read()) {
+      case 'p':
+        telemetryFlush();
+        profileDump(Serial);
+        break;
+      case 'P':
+        profileReset();
+        break;
+      case 'l':
+        telemetryFlush();
+        latencyDump(Serial);
+        break;
+      case 'L':
+        latencyReset();
+        break;
+      case 'j':
+        telemetryFlush();
+        animJitterDump(Serial);
+        break;
+      case 'J':
+        animJitterReset();
+        break;
+      case 'e':
+        telemetryFlush();
+        powerDump(Serial);
+        break;
+      case 'a':
+        telemetryFlush();
+        assetsDump(Serial);
+        break;
+      case 'b':
+        telemetryFlush();
+        blitBenchmark(Serial);
+        break;
+    }
+  }
+}
+
+void changeMode(byte newMode, uint16_t expireTime, byte maxFrames, TransitionKind transition) {
   mode = newMode;
-  frameDelay = 0;
+  animReset();
   timerStartTime = millis();
   timer = expireTime;
   maxFrameCount = maxFrames;
   curFrameCount = 0;
+  telemetryLog(LOG_MODE, newMode);
+  TRACE_BEGIN(TRACE_MODE, newMode);
+  applyModeSettings();
+  if (transition != TRANSITION_NONE) {
+    transitionStart(transition, TRANSITION_TIME);
+  }
+}
+
+// Animated clips with nothing on top go from flash or the frame cache straight to the panel
+bool streamable() {
+  bool clip = mode == MODE_BLINK || mode == MODE_SIDEEYE || mode == MODE_PETTING ||
+              mode == MODE_DIZZY || mode == MODE_SLEEP || mode == MODE_STUDY;
+  return clip && !transitionActive() && !fxEditsFrame();
+}
+
+// Effects, CPU clock and working state that belong to the current mode
+void applyModeSettings() {
+  powerClock(mode != MODE_SLEEP && mode != MODE_STUDY && mode != MODE_MEMES);
+  fxReset();
+  if (mode == MODE_FLAPPY) {
+    flappyEnter();
+  } else if (mode == MODE_EYES) {
+    eyesEnter();
+  } else {
+    arenaLeave();
+  }
+  if (mode == MODE_SLEEP) {
+    fxBreathe(0x08, FX_CONTRAST_DEFAULT, 4000);
+  } else if (mode == MODE_DIZZY) {
+    fxFlash(80);
+  }
+}
+
+// Idle sleep, light sleeps in short steps until the toy is touched or the MPU sees motion
+void idleSleep() {
+  sensors_event_t a = {}, g, temp;
+  if (mpuReady) {
+    mpu.getEvent(&a, &g, &temp);
+  }
+  sensors_vec_t rest = a.acceleration;
+
+  detachInterrupt(digitalPinToInterrupt(TOUCH_PIN));
+  while (!powerIdleSleep()) {
+    if (!mpuReady) {
+      continue;
+    }
+    mpu.getEvent(&a, &g, &temp);
+    if (moved(rest, a.acceleration)) {
+      break;
+    }
+  }
+  attachInterrupt(digitalPinToInterrupt(TOUCH_PIN), IRQHandler, CHANGE);
+
+  powerWake();
+  applyModeSettings();
+  mpuPrevAccel = a.acceleration;
+  animReset();  // next loop draws the mode again
+}
+
+bool moved(const sensors_vec_t &from, const sensors_vec_t &to) {
+  return abs(to.x - from.x) > POWER_MOTION_THRESHOLD || abs(to.y - from.y) > POWER_MOTION_THRESHOLD || abs(to.z - from.z) > POWER_MOTION_THRESHOLD;
 }
 
 void delayFrame(uint16_t delay) {
-  frameDelay = delay;
-  framePausedTime = millis();
+  TRACE_BEGIN(TRACE_PAUSE, delay);
+  animHold(delay);
+}
+
+// Frames that pause on purpose, skipping must never jump over them
+bool holdFrame(byte frame) {
+  if (mode == MODE_BLINK) {
+    return frame == 0 || frame == maxFrameCount / 2;
+  }
+  if (mode == MODE_SIDEEYE) {
+    return frame == maxFrameCount / 2 || frame == maxFrameCount - 1;
+  }
+  return false;
+}
+
+// When the render path fell behind, drop frames so the clip keeps its speed
+void skipLateFrames() {
+  if (maxFrameCount < 2) {
+    return;
+  }
+  uint8_t late = animLateFrames();
+  uint8_t skip = 0;
+  while (skip < late && !holdFrame((curFrameCount + skip) % maxFrameCount)) {
+    skip++;
+  }
+  curFrameCount = (curFrameCount + skip) % maxFrameCount;
+  animDropped(skip);
 }
\ No newline at end of file
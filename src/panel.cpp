@@ -0,0 +1,258 @@
+#include "panel.h"
+#include <Wire.h>
+#include <SPI.h>
+#include "pins.h"
+#include "effects.h"
+
+#define PANEL_SPI_CLOCK 8000000
+
+// Wire refuses transmissions longer than its buffer, one byte goes to the control byte
+#ifdef BUFFER_LENGTH
+#define PANEL_I2C_CHUNK (BUFFER_LENGTH - 1)
+#else
+#define PANEL_I2C_CHUNK 31
+#endif
+
+#if defined(PANEL_MOCK)
+PanelDriver panel;
+#elif defined(PANEL_SPI)
+PanelDriver panel(PANEL_DC, PANEL_CS, PANEL_RST);
+#else
+PanelDriver panel(PANEL_I2C_ADDRESS);
+#endif
+
+/**
+ * wakes the bus and sends the controller's power-up sequence, the panel is
+ * left on and with its RAM untouched
+ */
+bool Panel::begin() {
+  if (!attach()) {
+    return false;
+  }
+
+#ifdef PANEL_SH1106
+  static const uint8_t init[] = {
+    SSD1306_DISPLAYOFF,
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+    SSD1306_SETMULTIPLEX, SCREEN_HEIGHT - 1,
+    SSD1306_SETDISPLAYOFFSET, 0x00,
+    SSD1306_SETSTARTLINE | 0x00,
+    SH1106_DCDC, 0x8B,
+    SSD1306_SEGREMAP | 0x01,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, SCREEN_HEIGHT == 64 ? 0x12 : 0x02,
+    SSD1306_SETCONTRAST, FX_CONTRAST_DEFAULT,
+    SSD1306_SETPRECHARGE, 0x1F,
+    SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME,
+    SSD1306_NORMALDISPLAY,
+    SSD1306_DISPLAYON,
+  };
+#else
+  static const uint8_t init[] = {
+    SSD1306_DISPLAYOFF,
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+    SSD1306_SETMULTIPLEX, SCREEN_HEIGHT - 1,
+    SSD1306_SETDISPLAYOFFSET, 0x00,
+    SSD1306_SETSTARTLINE | 0x00,
+    SSD1306_CHARGEPUMP, 0x14,
+    SSD1306_MEMORYMODE, 0x00,
+    SSD1306_SEGREMAP | 0x01,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, SCREEN_HEIGHT == 64 ? 0x12 : 0x02,
+    SSD1306_SETCONTRAST, FX_CONTRAST_DEFAULT,
+    SSD1306_SETPRECHARGE, 0xF1,
+    SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME,
+    SSD1306_NORMALDISPLAY,
+    SSD1306_DEACTIVATE_SCROLL,
+    SSD1306_DISPLAYON,
+  };
+#endif
+  commands(init, sizeof(init));
+  return true;
+}
+
+/**
+ * sends a window of a page-major framebuffer, the SSD1306 wraps inside the
+ * window so full-width windows go out in one transfer
+ */
+void Panel::flush(const uint8_t *buffer, uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+  uint16_t columns = lastColumn - firstColumn + 1;
+  const uint8_t *row = buffer + firstPage * SCREEN_WIDTH + firstColumn;
+
+#ifdef PANEL_SH1106
+  uint8_t column = firstColumn + PANEL_COLUMN_OFFSET;
+  for (uint8_t p = firstPage; p <= lastPage; p++, row += SCREEN_WIDTH) {
+    const uint8_t at[] = {
+      (uint8_t)(SH1106_SETPAGE | p),
+      (uint8_t)(SH1106_SETLOWCOLUMN | (column & 0x0F)),
+      (uint8_t)(SH1106_SETHIGHCOLUMN | (column >> 4)),
+    };
+    commands(at, sizeof(at));
+    data(row, columns);
+  }
+#else
+  const uint8_t window[] = {
+    SSD1306_COLUMNADDR, firstColumn, lastColumn,
+    SSD1306_PAGEADDR, firstPage, lastPage,
+  };
+  commands(window, sizeof(window));
+
+  if (columns == SCREEN_WIDTH) {
+    data(row, (lastPage - firstPage + 1) * SCREEN_WIDTH);
+  } else {
+    for (uint8_t p = firstPage; p <= lastPage; p++, row += SCREEN_WIDTH) {
+      data(row, columns);
+    }
+  }
+#endif
+  bytesSent += (lastPage - firstPage + 1) * columns;
+}
+
+/**
+ * sends a full frame page by page. fill() hands over each page just before
+ * it goes out, written into row or already somewhere in RAM
+ */
+void Panel::stream(const uint8_t *(*fill)(uint8_t page, uint8_t *row)) {
+  uint8_t row[SCREEN_WIDTH] __attribute__((aligned(4)));
+
+#ifdef PANEL_SH1106
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    const uint8_t *page = fill(p, row);
+    const uint8_t at[] = {
+      (uint8_t)(SH1106_SETPAGE | p),
+      (uint8_t)(SH1106_SETLOWCOLUMN | (PANEL_COLUMN_OFFSET & 0x0F)),
+      (uint8_t)(SH1106_SETHIGHCOLUMN | (PANEL_COLUMN_OFFSET >> 4)),
+    };
+    commands(at, sizeof(at));
+    data(page, SCREEN_WIDTH);
+  }
+#else
+  const uint8_t window[] = {
+    SSD1306_COLUMNADDR, 0, SCREEN_WIDTH - 1,
+    SSD1306_PAGEADDR, 0, SCREEN_PAGES - 1,
+  };
+  commands(window, sizeof(window));
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    data(fill(p, row), SCREEN_WIDTH);
+  }
+#endif
+  bytesSent += SCREEN_WIDTH * SCREEN_PAGES;
+}
+
+bool I2cPanel::attach() {
+  Wire.begin();
+  Wire.setClock(I2C_CLOCK);
+  Wire.beginTransmission(address);
+  return Wire.endTransmission() == 0;
+}
+
+void I2cPanel::send(uint8_t control, const uint8_t *bytes, uint16_t count) {
+  while (count) {
+    uint16_t n = count < PANEL_I2C_CHUNK ? count : PANEL_I2C_CHUNK;
+    Wire.beginTransmission(address);
+    Wire.write(control);
+    Wire.write(bytes, n);
+    Wire.endTransmission();
+    bytes += n;
+    count -= n;
+  }
+}
+
+void I2cPanel::commands(const uint8_t *list, uint8_t count) {
+  send(0x00, list, count);
+}
+
+void I2cPanel::data(const uint8_t *bytes, uint16_t count) {
+  send(0x40, bytes, count);
+}
+
+bool SpiPanel::attach() {
+  pinMode(dc, OUTPUT);
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  SPI.begin();
+
+  // SPI modules have no power-on reset of their own
+  pinMode(rst, OUTPUT);
+  digitalWrite(rst, LOW);
+  delay(10);
+  digitalWrite(rst, HIGH);
+  delay(10);
+
+  return true;  // nothing to ask on a write-only bus
+}
+
+void SpiPanel::send(uint8_t level, const uint8_t *bytes, uint16_t count) {
+  SPI.beginTransaction(SPISettings(PANEL_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+  digitalWrite(dc, level);
+  digitalWrite(cs, LOW);
+  SPI.writeBytes(bytes, count);
+  digitalWrite(cs, HIGH);
+  SPI.endTransaction();
+}
+
+void SpiPanel::commands(const uint8_t *list, uint8_t count) {
+  send(LOW, list, count);
+}
+
+void SpiPanel::data(const uint8_t *bytes, uint16_t count) {
+  send(HIGH, bytes, count);
+}
+
+/**
+ * follows the address window like the controller does, everything else
+ * is only counted
+ */
+void MockPanel::commands(const uint8_t *list, uint8_t count) {
+  commandBytes += count;
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t c = list[i];
+    if (skip) {
+      skip--;
+    } else if (pending) {
+      args[argCount++] = c;
+      if (argCount == 2) {
+        if (pending == SSD1306_COLUMNADDR) {
+          firstColumn = column = args[0];
+          lastColumn = args[1];
+        } else {
+          firstPage = page = args[0];
+          lastPage = args[1];
+        }
+        pending = 0;
+      }
+    } else if ((c & 0xF8) == SH1106_SETPAGE) {
+      page = c & 0x07;
+    } else if (c < SH1106_SETHIGHCOLUMN + 0x10) {
+      ramColumn = c < SH1106_SETHIGHCOLUMN ? (ramColumn & 0xF0) | (c & 0x0F) : (c & 0x0F) << 4 | (ramColumn & 0x0F);
+      column = ramColumn - PANEL_COLUMN_OFFSET;
+    } else if (c == SSD1306_COLUMNADDR || c == SSD1306_PAGEADDR) {
+      pending = c;
+      argCount = 0;
+    } else if (c == SSD1306_LEFT_HORIZONTAL_SCROLL || c == SSD1306_RIGHT_HORIZONTAL_SCROLL) {
+      skip = 6;
+    } else if (c == SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL || c == SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL) {
+      skip = 5;
+    } else if (c == SSD1306_SET_VERTICAL_SCROLL_AREA) {
+      skip = 2;
+    } else if (c == SSD1306_SETCONTRAST || c == SSD1306_SETDISPLAYCLOCKDIV || c == SSD1306_SETMULTIPLEX ||
+               c == SSD1306_SETDISPLAYOFFSET || c == SSD1306_CHARGEPUMP || c == SSD1306_MEMORYMODE ||
+               c == SSD1306_SETCOMPINS || c == SSD1306_SETPRECHARGE || c == SSD1306_SETVCOMDETECT ||
+               c == SH1106_DCDC) {
+      skip = 1;
+    }
+  }
+}
+
+void MockPanel::data(const uint8_t *bytes, uint16_t count) {
+  writes++;
+  while (count--) {
+    ram[page * SCREEN_WIDTH + column] = *bytes++;
+    if (column++ == lastColumn) {
+      column = firstColumn;
+      page = page == lastPage ? firstPage : page + 1;
+    }
+  }
+}
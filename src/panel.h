@@ -0,0 +1,151 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Display drivers. The framebuffer (framebuffer.h) only knows pages of 8
+   vertical pixels, a Panel gets them into the controller over the bus it is
+   wired to and carries the command bytes the effects and the power manager
+   send. The driver is picked at build time:
+
+     (default)      SSD1306 on I2C, shared with the MPU6050
+     -DPANEL_SPI    SSD1306 on hardware SPI, see pins.h for the wiring
+     -DPANEL_MOCK   no panel at all, keeps a copy of the panel RAM and counts
+                    the traffic, for host builds and boards without a screen
+
+   -DPANEL_SH1106 swaps the controller for the SH1106 on either bus. It has
+   132 columns of RAM with the glass centred on them and only page addressing,
+   so every page goes out on its own at PANEL_COLUMN_OFFSET. It cannot scroll,
+   the effects fall back to the framebuffer for that.
+
+   The geometry is -DSCREEN_WIDTH/-DSCREEN_HEIGHT, tools/gen_assets.py builds
+   the frame headers to match.
+
+   flush() can send any window of columns and pages, so partial updates only
+   cost the bytes that changed. stream() sends a whole frame that is not in
+   any buffer, a page at a time as a callback produces it.
+*/
+
+#ifndef SCREEN_WIDTH
+#define SCREEN_WIDTH 128
+#endif
+#ifndef SCREEN_HEIGHT
+#define SCREEN_HEIGHT 64
+#endif
+#define SCREEN_PAGES (SCREEN_HEIGHT / 8)
+
+#ifdef PANEL_SH1106
+#define PANEL_COLUMN_OFFSET 2
+#else
+#define PANEL_COLUMN_OFFSET 0
+#endif
+
+// SSD1306 commands
+#define SSD1306_MEMORYMODE 0x20
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define SSD1306_RIGHT_HORIZONTAL_SCROLL 0x26
+#define SSD1306_LEFT_HORIZONTAL_SCROLL 0x27
+#define SSD1306_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL 0x29
+#define SSD1306_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL 0x2A
+#define SSD1306_DEACTIVATE_SCROLL 0x2E
+#define SSD1306_ACTIVATE_SCROLL 0x2F
+#define SSD1306_SETSTARTLINE 0x40
+#define SSD1306_SETCONTRAST 0x81
+#define SSD1306_CHARGEPUMP 0x8D
+#define SSD1306_SEGREMAP 0xA0
+#define SSD1306_SET_VERTICAL_SCROLL_AREA 0xA3
+#define SSD1306_DISPLAYALLON_RESUME 0xA4
+#define SSD1306_NORMALDISPLAY 0xA6
+#define SSD1306_INVERTDISPLAY 0xA7
+#define SSD1306_SETMULTIPLEX 0xA8
+#define SSD1306_DISPLAYOFF 0xAE
+#define SSD1306_DISPLAYON 0xAF
+#define SSD1306_COMSCANDEC 0xC8
+#define SSD1306_SETDISPLAYOFFSET 0xD3
+#define SSD1306_SETDISPLAYCLOCKDIV 0xD5
+#define SSD1306_SETPRECHARGE 0xD9
+#define SSD1306_SETCOMPINS 0xDA
+#define SSD1306_SETVCOMDETECT 0xDB
+
+// SH1106 page addressing, the same codes also work on the SSD1306
+#define SH1106_SETLOWCOLUMN 0x00
+#define SH1106_SETHIGHCOLUMN 0x10
+#define SH1106_SETPAGE 0xB0
+#define SH1106_DCDC 0xAD
+
+class Panel {
+ public:
+  bool begin();
+  void command(uint8_t c) { commands(&c, 1); }
+  virtual void commands(const uint8_t *list, uint8_t count) = 0;
+
+  void flush(const uint8_t *buffer) { flush(buffer, 0, SCREEN_PAGES - 1, 0, SCREEN_WIDTH - 1); }
+  void flush(const uint8_t *buffer, uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+  void stream(const uint8_t *(*fill)(uint8_t page, uint8_t *row));
+
+  uint32_t bytesSent = 0;  // framebuffer bytes, commands not included
+
+ protected:
+  virtual bool attach() = 0;  // bus setup, false when nothing answers
+  virtual void data(const uint8_t *bytes, uint16_t count) = 0;
+};
+
+class I2cPanel final : public Panel {
+ public:
+  I2cPanel(uint8_t address) : address(address) {}
+  void commands(const uint8_t *list, uint8_t count) override;
+
+ protected:
+  bool attach() override;
+  void data(const uint8_t *bytes, uint16_t count) override;
+
+ private:
+  void send(uint8_t control, const uint8_t *bytes, uint16_t count);
+  const uint8_t address;
+};
+
+class SpiPanel final : public Panel {
+ public:
+  SpiPanel(uint8_t dc, uint8_t cs, uint8_t rst) : dc(dc), cs(cs), rst(rst) {}
+  void commands(const uint8_t *list, uint8_t count) override;
+
+ protected:
+  bool attach() override;
+  void data(const uint8_t *bytes, uint16_t count) override;
+
+ private:
+  void send(uint8_t level, const uint8_t *bytes, uint16_t count);
+  const uint8_t dc, cs, rst;
+};
+
+class MockPanel final : public Panel {
+ public:
+  void commands(const uint8_t *list, uint8_t count) override;
+
+  uint8_t ram[SCREEN_WIDTH * SCREEN_PAGES];  // what the panel would show
+  uint32_t commandBytes = 0;
+  uint32_t writes = 0;  // data transfers, one per flushed window or page row
+
+ protected:
+  bool attach() override { return true; }
+  void data(const uint8_t *bytes, uint16_t count) override;
+
+ private:
+  uint8_t pending = 0;  // command still collecting arguments
+  uint8_t args[2];
+  uint8_t argCount = 0;
+  uint8_t skip = 0;  // arguments of commands the mock ignores
+  uint8_t ramColumn = 0;  // page addressing, before taking off the offset
+  uint8_t column = 0, firstColumn = 0, lastColumn = SCREEN_WIDTH - 1;
+  uint8_t page = 0, firstPage = 0, lastPage = SCREEN_PAGES - 1;
+};
+
+#if defined(PANEL_MOCK)
+typedef MockPanel PanelDriver;
+#elif defined(PANEL_SPI)
+typedef SpiPanel PanelDriver;
+#else
+typedef I2cPanel PanelDriver;
+#endif
+
+extern PanelDriver panel;
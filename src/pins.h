@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Pin assignments on the D1 mini. The MPU6050 and the I2C panel share D1/D2.
+
+   Hardware SPI owns D5 (SCK) and D7 (MOSI), so with an SPI panel the touch
+   sensor moves to D6. That is the MISO pin, which the write-only panel never
+   reads, so it is handed back to GPIO after SPI.begin().
+*/
+
+#ifdef PANEL_SPI
+#define TOUCH_PIN D6
+#else
+#define TOUCH_PIN D5
+#endif
+
+#define PANEL_I2C_ADDRESS 0x3C
+#define MPU_I2C_ADDRESS 0x68
+#define I2C_CLOCK 400000  // D1/D2, the MPU6050 is fine at this speed too
+
+// SPI panel control lines, D3 and D8 only need their boot levels before setup()
+#define PANEL_DC D3
+#define PANEL_CS D8
+#define PANEL_RST D0
@@ -0,0 +1,174 @@
+#include "power.h"
+#include <ESP8266WiFi.h>
+#include <Wire.h>
+#include <coredecls.h>
+#include "panel.h"
+#include "pins.h"
+#include "effects.h"
+#include "telemetry.h"
+
+extern "C" {
+#include <user_interface.h>
+}
+
+// Estimated draw per state in 0.1 mA: ESP8266 with the modem off, panel at the
+// average amount of lit pixels, MPU6050 and the D1 mini regulator/USB chip
+static const uint16_t stateCurrent[POWER_STATE_COUNT] = { 510, 410, 330, 100 };
+static const char *const stateNames[POWER_STATE_COUNT] = { "fast", "eco", "dim", "idle sleep" };
+
+static PowerState state = POWER_FAST;
+static bool fastClock = true;
+static unsigned long stateSince;
+static unsigned long stateTime[POWER_STATE_COUNT];
+static volatile unsigned long lastActivity;
+static volatile bool woke;       // the light sleep ended
+static volatile bool touchWoke;  // and D5 was still high when it did
+
+/**
+ * called by the core before the SDK brings the radio up, the toy never uses it
+ */
+extern "C" void preinit() {
+  ESP8266WiFiClass::preinitWiFiOff();
+}
+
+static void setState(PowerState next) {
+  if (next == state) {
+    return;
+  }
+  unsigned long now = millis();
+  stateTime[state] += now - stateSince;
+  stateSince = now;
+
+  // the panel keeps its RAM while off, so waking shows the last frame right away
+  if (state == POWER_IDLE_SLEEP) {
+    panel.command(SSD1306_DISPLAYON);
+  }
+  if (next == POWER_IDLE_SLEEP) {
+    panel.command(SSD1306_DISPLAYOFF);
+  } else if (next == POWER_DIM) {
+    fxFade(POWER_DIM_CONTRAST, 2000);
+  }
+
+  uint8_t mhz = next == POWER_FAST ? SYS_CPU_160MHZ : SYS_CPU_80MHZ;
+  system_update_cpu_freq(mhz);
+  // the software I2C counts its delays in CPU cycles for F_CPU, at half the
+  // clock it has to be asked for twice the rate to stay at I2C_CLOCK
+  Wire.setClock(I2C_CLOCK * (F_CPU / 1000000L) / mhz);
+  state = next;
+  telemetryLog(LOG_POWER, next);
+}
+
+void powerBegin() {
+  stateSince = millis();
+  lastActivity = stateSince;
+}
+
+/**
+ * clock for the current mode, busy modes run at 160 MHz
+ */
+void powerClock(bool fast) {
+  fastClock = fast;
+  setState(fast ? POWER_FAST : POWER_ECO);
+}
+
+/**
+ * any input, called from the button interrupt and on MPU motion
+ */
+void IRAM_ATTR powerActivity() {
+  lastActivity = millis();
+}
+
+/**
+ * dims the panel after a while in the sleep menu, any input brings it back.
+ * The dim fade took over from the mode's effects, returns true when it ended
+ * and the caller restores the mode
+ */
+bool powerUpdate(bool sleeping) {
+  unsigned long idle = millis() - lastActivity;
+
+  if (sleeping && idle > POWER_DIM_AFTER) {
+    setState(POWER_DIM);
+  } else if (state == POWER_DIM) {
+    setState(fastClock ? POWER_FAST : POWER_ECO);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * true once nobody touched or moved the toy for long enough to go to idle sleep
+ */
+bool powerIdle(bool sleeping) {
+  return millis() - lastActivity > (sleeping ? POWER_SLEEP_IDLE_AFTER : POWER_IDLE_AFTER);
+}
+
+/**
+ * the SDK is back from light sleep, by the timer or by D5. The level is
+ * latched here, a tap can be over long before the sleep call returns
+ */
+static void wakeUp() {
+  touchWoke = digitalRead(TOUCH_PIN);
+  woke = true;
+  esp_schedule();
+}
+
+/**
+ * switches the panel off and light sleeps for up to POWER_WAKE_INTERVAL,
+ * returns true when a touch woke the CPU
+ */
+bool powerIdleSleep() {
+  setState(POWER_IDLE_SLEEP);
+
+  // the modem sits in forced modem sleep since preinit(), swap that for light sleep
+  wifi_fpm_close();
+  wifi_set_opmode_current(NULL_MODE);
+  wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+  wifi_fpm_open();
+  gpio_pin_wakeup_enable(GPIO_ID_PIN(TOUCH_PIN), GPIO_PIN_INTR_HILEVEL);
+  woke = false;
+  touchWoke = false;
+  wifi_fpm_set_wakeup_cb(wakeUp);
+  wifi_fpm_do_sleep(POWER_WAKE_INTERVAL * 1000UL);
+  // the sleep only starts once the SDK gets control, it ends early on a touch
+  esp_delay(POWER_WAKE_INTERVAL + 1, []() { return !woke; });
+
+  gpio_pin_wakeup_disable();
+  wifi_fpm_close();
+  wifi_fpm_set_sleep_type(MODEM_SLEEP_T);
+  wifi_fpm_open();
+  wifi_fpm_do_sleep(0xFFFFFFF);
+
+  return touchWoke || digitalRead(TOUCH_PIN);
+}
+
+/**
+ * leaves idle sleep, the caller restores the mode
+ */
+void powerWake() {
+  powerActivity();
+  setState(fastClock ? POWER_FAST : POWER_ECO);
+}
+
+void powerDump(Print &out) {
+  unsigned long now = millis();
+  uint32_t charge = 0;  // in 0.1 mA * s
+
+  out.print("power @");
+  out.print(ESP.getCpuFreqMHz());
+  out.println("MHz");
+  for (uint8_t i = 0; i < POWER_STATE_COUNT; i++) {
+    unsigned long t = stateTime[i] + (i == state ? now - stateSince : 0);
+    charge += stateCurrent[i] * (t / 1000);
+    out.print(stateNames[i]);
+    out.print(i == state ? " * " : "   ");
+    out.print(stateCurrent[i] / 10);
+    out.print(".");
+    out.print(stateCurrent[i] % 10);
+    out.print("mA ");
+    out.print(t / 1000);
+    out.println("s");
+  }
+  out.print("used ~");
+  out.print(charge / 36);  // 0.1 mA * s to uAh
+  out.println("uAh");
+}
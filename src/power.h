@@ -0,0 +1,39 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Power management. The Wi-Fi modem is switched off before the SDK starts it,
+   the CPU clock follows the mode, and without touch or motion for a while the
+   toy dims and then goes to idle sleep: panel off and the CPU in light sleep,
+   woken by D5 or by the MPU noticing motion. Every state has an estimated
+   current draw, 'e' over Serial prints the time spent per state and the
+   estimated charge used.
+
+   The firmware is built for 160 MHz and only ever clocks down. The core times
+   its software I2C for the build clock, every switch sets the bus again so
+   it stays at I2C_CLOCK (pins.h) at 80 MHz instead of dropping to half.
+*/
+
+#define POWER_DIM_AFTER 300000UL         // ms without input in the sleep menu before dimming
+#define POWER_IDLE_AFTER 600000UL        // ms without touch or motion before idle sleep
+#define POWER_SLEEP_IDLE_AFTER 1800000UL // same for the sleep menu, which is meant to be left alone
+#define POWER_WAKE_INTERVAL 500          // ms of light sleep between motion checks
+#define POWER_MOTION_THRESHOLD 1.5       // m/s^2 change between MPU samples that counts as motion
+#define POWER_DIM_CONTRAST 0x01
+
+enum PowerState : uint8_t {
+  POWER_FAST,        // 160 MHz, panel on
+  POWER_ECO,         // 80 MHz, panel on
+  POWER_DIM,         // 80 MHz, panel at minimum contrast
+  POWER_IDLE_SLEEP,  // CPU in light sleep, panel off
+  POWER_STATE_COUNT
+};
+
+void powerBegin();
+void powerClock(bool fast);
+void powerActivity();
+bool powerUpdate(bool sleeping);
+bool powerIdle(bool sleeping);
+bool powerIdleSleep();
+void powerWake();
+void powerDump(Print &out);
@@ -0,0 +1,26 @@
+#include "profiler.h"
+
+#ifdef MAO_PROFILE
+
+Histogram profileStages[STAGE_COUNT];
+
+static const char *const stageNames[STAGE_COUNT] = {
+  "frame", "clear", "draw", "flappy", "flush", "mpu", "tilt", "buttons"
+};
+
+void profileReset() {
+  for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+    histogramReset(profileStages[i]);
+  }
+}
+
+void profileDump(Print &out) {
+  out.print("profile @");
+  out.print(ESP.getCpuFreqMHz());
+  out.println("MHz");
+  for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+    histogramPrint(out, stageNames[i], profileStages[i]);
+  }
+}
+
+#endif
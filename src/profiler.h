@@ -0,0 +1,51 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Per-stage frame time instrumentation.
+
+   Build with -DMAO_PROFILE (see the d1_mini_profile env) to enable it, otherwise
+   every macro and call below compiles to nothing. Stages are timed with micros()
+   and recorded into histograms, send 'p' over Serial to dump them and 'P' to
+   reset. Not with the cycle counter: powerClock() switches between 80 and
+   160 MHz, and a stage that spans the switch would be converted at the
+   wrong rate.
+*/
+
+enum ProfileStage {
+  STAGE_FRAME,    // whole render, clear to flush
+  STAGE_CLEAR,    // display.clearDisplay()
+  STAGE_DRAW,     // blitFrame() or pack decode of the animation frame
+  STAGE_FLAPPY,   // flappyLoop()
+  STAGE_FLUSH,    // display.display()
+  STAGE_MPU,      // mpu.getEvent()
+  STAGE_TILT,     // tiltSample() burst read
+  STAGE_BUTTONS,  // button sequence processing
+  STAGE_COUNT
+};
+
+#ifdef MAO_PROFILE
+
+#include "histogram.h"
+
+extern Histogram profileStages[STAGE_COUNT];
+
+static inline void profileRecord(ProfileStage stage, uint32_t us) {
+  histogramRecord(profileStages[stage], us);
+}
+
+#define PROFILE_BEGIN(stage) uint32_t _profile_##stage = micros()
+#define PROFILE_END(stage) profileRecord(stage, micros() - _profile_##stage)
+
+void profileReset();
+void profileDump(Print &out);
+
+#else
+
+#define PROFILE_BEGIN(stage)
+#define PROFILE_END(stage)
+
+static inline void profileReset() {}
+static inline void profileDump(Print &) {}
+
+#endif
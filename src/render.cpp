@@ -0,0 +1,69 @@
+#include "render.h"
+#include "framebuffer.h"
+#include "trace.h"
+#include "latency.h"
+#include "effects.h"
+
+uint32_t flushCount = 0;
+
+static void sendWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+  fxBeforeFlush();
+  TRACE_BEGIN(TRACE_FLUSH, lastPage - firstPage + 1);
+  display.display(firstPage, lastPage, firstColumn, lastColumn);
+  TRACE_END(TRACE_FLUSH, 0);
+  fxAfterFlush();
+}
+
+/**
+ * sends the framebuffer to the panel
+ */
+void flushDisplay() {
+  flushDisplayPages(0, SCREEN_PAGES - 1);
+}
+
+/**
+ * sends only the given pages, for updates that touch a band of the frame
+ */
+void flushDisplayPages(uint8_t firstPage, uint8_t lastPage) {
+  flushDisplayWindow(firstPage, lastPage, 0, SCREEN_WIDTH - 1);
+}
+
+/**
+ * sends a window of columns on the given pages, for small moving parts
+ */
+void flushDisplayWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn) {
+  sendWindow(firstPage, lastPage, firstColumn, lastColumn);
+  flushPartsDone(true);
+}
+
+/**
+ * sends pages as one part of a flush, flushPartsDone() closes it
+ */
+void flushDisplayPart(uint8_t firstPage, uint8_t lastPage) {
+  sendWindow(firstPage, lastPage, 0, SCREEN_WIDTH - 1);
+}
+
+/**
+ * counts the parts sent so far as one flush, the latency probe sees it
+ * when it completed the frame
+ */
+void flushPartsDone(bool complete) {
+  flushCount++;
+  if (complete) {
+    latencyFlushed(micros());
+  }
+}
+
+/**
+ * sends a full frame fill() produces page by page instead of the framebuffer,
+ * see Panel::stream()
+ */
+void flushStream(const uint8_t *(*fill)(uint8_t page, uint8_t *row)) {
+  fxBeforeFlush();
+  TRACE_BEGIN(TRACE_FLUSH, SCREEN_PAGES);
+  panel.stream(fill);
+  TRACE_END(TRACE_FLUSH, 0);
+  fxAfterFlush();
+  flushCount++;
+  latencyFlushed(micros());
+}
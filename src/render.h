@@ -0,0 +1,23 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Shared render helpers. Every flush of the framebuffer goes through
+   flushDisplay() or flushDisplayPages() so tracing, latency probes and
+   statistics see all of them, and so do frames streamed past the
+   framebuffer with flushStream().
+
+   An update that goes out in parts, a transition step that composes its
+   pages one by one, sends them with flushDisplayPart() and closes with
+   flushPartsDone(), so it counts as one flush and only reaches the latency
+   probe once the frame it carries is complete.
+*/
+
+extern uint32_t flushCount;
+
+void flushDisplay();
+void flushDisplayPages(uint8_t firstPage, uint8_t lastPage);
+void flushDisplayWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn);
+void flushDisplayPart(uint8_t firstPage, uint8_t lastPage);
+void flushPartsDone(bool complete);
+void flushStream(const uint8_t *(*fill)(uint8_t page, uint8_t *row));
@@ -0,0 +1,158 @@
+#include "replay.h"
+
+#if defined(MAO_RECORD) || defined(MAO_REPLAY)
+
+#include "telemetry.h"
+
+static unsigned long epoch;  // millis() at replayBegin(), all log times are relative to it
+
+/**
+ * randomSeed(0) is ignored on the ESP8266, the run would not repeat
+ */
+static uint32_t nonZero(uint32_t seed) {
+  return seed ? seed : 1;
+}
+
+#ifdef MAO_RECORD
+
+static void IRAM_ATTR record(uint8_t kind, const void *data, uint8_t len) {
+  uint8_t payload[1 + 4 + 12];
+  uint32_t ms = millis() - epoch;
+  payload[0] = kind;
+  memcpy(payload + 1, &ms, 4);
+  memcpy(payload + 5, data, len);
+  telemetryWrite(TLM_INPUT, payload, 5 + len);
+}
+
+uint32_t replaySeed(uint32_t seed) {
+  seed = nonZero(seed);
+  record(REPLAY_SEED, &seed, sizeof(seed));
+  return seed;
+}
+
+void IRAM_ATTR replayEdge(byte level) {
+  record(level ? REPLAY_EDGE_HIGH : REPLAY_EDGE_LOW, NULL, 0);
+}
+
+void replayMpu(sensors_vec_t &acceleration) {
+  float v[3] = { acceleration.x, acceleration.y, acceleration.z };
+  record(REPLAY_MPU, v, sizeof(v));
+}
+
+void replayTilt(int16_t raw[3]) {
+  record(REPLAY_TILT, raw, 3 * sizeof(int16_t));
+}
+
+void replayBegin(ReplayEdgeHandler) {
+  epoch = millis();
+}
+
+#else
+
+#include <Ticker.h>
+#include "scenario.h"
+#include "tilt.h"
+
+#define HEADER_SIZE 9
+
+static Ticker edgeTicker;
+static ReplayEdgeHandler edgeHandler;
+
+// The timeline and each kind of sample are read with separate cursors,
+// edges follow the clock while samples follow the polls
+static uint16_t edgePos = HEADER_SIZE;
+static uint32_t edgeTime = 0;
+static uint16_t mpuPos = HEADER_SIZE;
+static uint16_t tiltPos = HEADER_SIZE;
+
+static uint8_t entrySize(uint8_t kind) {
+  switch (kind) {
+    case REPLAY_MPU:
+      return 3 + 12;
+    case REPLAY_TILT:
+      return 3 + 6;
+    default:
+      return 3;
+  }
+}
+
+/**
+ * copies the payload of the next entry of that kind and moves the cursor
+ * past it, false at the end of the log
+ */
+static bool nextSample(uint16_t &pos, uint8_t kind, void *payload, uint8_t len) {
+  while (pos < sizeof(scenario)) {
+    uint8_t entry = pgm_read_byte(scenario + pos);
+    uint16_t at = pos;
+    pos += entrySize(entry);
+    if (entry == kind) {
+      memcpy_P(payload, scenario + at + 3, len);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t replaySeed(uint32_t) {
+  uint32_t seed;
+  memcpy_P(&seed, scenario + 5, sizeof(seed));
+  return nonZero(seed);
+}
+
+void replayEdge(byte) {}
+
+void replayMpu(sensors_vec_t &acceleration) {
+  float v[3];
+  if (nextSample(mpuPos, REPLAY_MPU, v, sizeof(v))) {
+    acceleration.x = v[0];
+    acceleration.y = v[1];
+    acceleration.z = v[2];
+    return;
+  }
+  // past the end of the log the device just lies still
+  acceleration.x = 0;
+  acceleration.y = 0;
+  acceleration.z = 9.8;
+}
+
+void replayTilt(int16_t raw[3]) {
+  if (!nextSample(tiltPos, REPLAY_TILT, raw, 3 * sizeof(int16_t))) {
+    raw[0] = 0;
+    raw[1] = 0;
+    raw[2] = TILT_ONE_G;
+  }
+}
+
+/**
+ * fires every edge that is due, then sleeps until the next one
+ */
+static void replayTick() {
+  while (edgePos < sizeof(scenario)) {
+    uint8_t kind = pgm_read_byte(scenario + edgePos);
+    uint16_t delta = pgm_read_byte(scenario + edgePos + 1) | pgm_read_byte(scenario + edgePos + 2) << 8;
+    uint32_t due = edgeTime + delta;
+    uint32_t now = millis() - epoch;
+
+    if (due > now) {
+      edgeTicker.once_ms(due - now, replayTick);
+      return;
+    }
+
+    edgeTime = due;
+    edgePos += entrySize(kind);
+    if (kind == REPLAY_EDGE_LOW || kind == REPLAY_EDGE_HIGH) {
+      edgeHandler(kind);
+    }
+  }
+  telemetryLog(LOG_REPLAY_DONE, edgeTime);
+}
+
+void replayBegin(ReplayEdgeHandler handler) {
+  edgeHandler = handler;
+  epoch = millis();
+  replayTick();
+}
+
+#endif
+
+#endif
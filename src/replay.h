@@ -0,0 +1,63 @@
+#pragma once
+#include <Arduino.h>
+#include <Adafruit_Sensor.h>
+
+/**
+   Deterministic input record and replay.
+
+   -DMAO_RECORD streams every input the firmware consumes (RNG seed, D5 edges,
+   MPU samples, raw tilt samples) through telemetry, tools/replay.py extracts them into a compact
+   .mrec log. -DMAO_REPLAY ignores the real inputs and plays the log compiled
+   into include/scenario.h instead (generate it with tools/replay.py header),
+   edges at their recorded time after replayBegin(), MPU and tilt samples in
+   poll order. Without either flag the hooks pass the real inputs straight through.
+
+   setup() calls replayBegin() before it attaches the touch interrupt, so
+   every edge, the ones that skip the splash too, is timed from the same
+   epoch in the recording and in the replay.
+
+   Log format, all little endian:
+     "MREC", version, uint32 seed, never 0, randomSeed(0) leaves the RNG alone
+     then entries of kind, uint16 ms since the previous entry, payload
+       REPLAY_EDGE_LOW / REPLAY_EDGE_HIGH  no payload
+       REPLAY_MPU                          3 float acceleration x, y, z
+       REPLAY_TILT                         3 int16 raw counts x, y, z, see tilt.h
+       REPLAY_WAIT                         nothing, only advances the time
+*/
+
+#define REPLAY_VERSION 2  // 2 added REPLAY_TILT
+
+enum ReplayKind : uint8_t {
+  REPLAY_EDGE_LOW = 0,
+  REPLAY_EDGE_HIGH = 1,
+  REPLAY_MPU = 2,
+  REPLAY_WAIT = 3,
+  REPLAY_SEED = 4,  // only in the recorded telemetry stream, the log keeps it in the header
+  REPLAY_TILT = 5,
+};
+
+typedef void (*ReplayEdgeHandler)(byte level);
+
+#if defined(MAO_RECORD) || defined(MAO_REPLAY)
+
+uint32_t replaySeed(uint32_t seed);
+void replayEdge(byte level);
+void replayMpu(sensors_vec_t &acceleration);
+void replayTilt(int16_t raw[3]);
+void replayBegin(ReplayEdgeHandler handler);
+
+#else
+
+static inline uint32_t replaySeed(uint32_t seed) { return seed; }
+static inline void replayEdge(byte) {}
+static inline void replayMpu(sensors_vec_t &) {}
+static inline void replayTilt(int16_t[3]) {}
+static inline void replayBegin(ReplayEdgeHandler) {}
+
+#endif
+
+#ifdef MAO_REPLAY
+#define REPLAYING 1
+#else
+#define REPLAYING 0
+#endif
@@ -0,0 +1,93 @@
+#include "telemetry.h"
+
+static uint8_t ring[TELEMETRY_RING_SIZE];
+static volatile uint16_t ringHead = 0;  // write position
+static volatile uint16_t ringTail = 0;  // read position
+static volatile uint16_t dropped = 0;
+
+#define RING_MASK (TELEMETRY_RING_SIZE - 1)
+
+void telemetryBegin() {
+  Serial.begin(TELEMETRY_BAUD);
+  telemetryLog(LOG_BOOT);
+}
+
+/**
+ * queues one record, callable from interrupts. returns false when the ring is full
+ */
+bool IRAM_ATTR telemetryWrite(uint8_t type, const void *payload, uint8_t len) {
+  uint16_t size = 4 + 4 + len;  // sync, type, len, timestamp, payload, checksum
+  uint32_t now = micros();
+  const uint8_t *p = (const uint8_t *)payload;
+
+  // raise the interrupt level instead of noInterrupts(), this also runs inside IRQHandler()
+  uint32_t savedLevel = xt_rsil(15);
+  if (TELEMETRY_RING_SIZE - 1 - ((ringHead - ringTail) & RING_MASK) < size) {
+    dropped++;
+    xt_wsr_ps(savedLevel);
+    return false;
+  }
+
+  uint16_t h = ringHead;
+  uint8_t sum = type ^ (len + 4);
+  ring[h++ & RING_MASK] = TELEMETRY_SYNC;
+  ring[h++ & RING_MASK] = type;
+  ring[h++ & RING_MASK] = len + 4;
+  for (uint8_t i = 0; i < 4; i++) {
+    uint8_t b = now >> (i * 8);
+    ring[h++ & RING_MASK] = b;
+    sum ^= b;
+  }
+  for (uint8_t i = 0; i < len; i++) {
+    ring[h++ & RING_MASK] = p[i];
+    sum ^= p[i];
+  }
+  ring[h++ & RING_MASK] = sum;
+  ringHead = h & RING_MASK;
+  xt_wsr_ps(savedLevel);
+  return true;
+}
+
+void IRAM_ATTR telemetryLog(uint8_t event, int32_t arg) {
+  uint8_t payload[5] = { event, (uint8_t)arg, (uint8_t)(arg >> 8), (uint8_t)(arg >> 16), (uint8_t)(arg >> 24) };
+  telemetryWrite(TLM_LOG, payload, sizeof(payload));
+}
+
+/**
+ * sends as much of the ring as fits in the UART fifo without blocking
+ */
+void telemetryDrain() {
+  // drops counted by an interrupt while the report goes out stay for the next one
+  uint32_t savedLevel = xt_rsil(15);
+  uint16_t lost = dropped;
+  xt_wsr_ps(savedLevel);
+  if (lost && telemetryWrite(TLM_DROPPED, &lost, sizeof(lost))) {
+    savedLevel = xt_rsil(15);
+    dropped -= lost;
+    xt_wsr_ps(savedLevel);
+  }
+
+  int room = Serial.availableForWrite();
+  while (room > 0 && ringTail != ringHead) {
+    uint16_t tail = ringTail;
+    uint16_t head = ringHead;
+    uint16_t chunk = (head > tail ? head : TELEMETRY_RING_SIZE) - tail;
+    if (chunk > room) {
+      chunk = room;
+    }
+    Serial.write(ring + tail, chunk);
+    ringTail = (tail + chunk) & RING_MASK;
+    room -= chunk;
+  }
+}
+
+/**
+ * blocks until the ring is empty, used before printing plain text
+ */
+void telemetryFlush() {
+  while (ringTail != ringHead) {
+    telemetryDrain();
+    yield();
+  }
+  Serial.flush();
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Binary telemetry, logged into a RAM ring buffer and drained to Serial
+   whenever the UART has room, so logging never blocks the frame.
+
+   Every record goes on the wire as
+     0xA5, type, len, payload[len], xor of type/len/payload
+   and the payload always starts with a little endian micros() timestamp.
+   Anything outside a record (like the 'p' profile dump) is plain text.
+   tools/telemetry.py decodes the stream, keep its tables in sync with the
+   enums below.
+*/
+
+#define TELEMETRY_BAUD 921600
+#define TELEMETRY_RING_SIZE 2048  // must be a power of two
+#define TELEMETRY_SYNC 0xA5
+
+// Record types
+enum TelemetryType : uint8_t {
+  TLM_LOG = 1,      // event id, int32 argument
+  TLM_DROPPED = 2,  // uint16 amount of records lost because the ring was full
+  TLM_TRACE = 3,    // span id, phase, uint16 argument, see trace.h
+  TLM_INPUT = 4,    // recorded input, kind, uint32 ms, payload, see replay.h
+  TLM_SOAK = 5,     // autopilot soak report, uint32 values, see autopilot.cpp
+};
+
+// Log events, replaces the old Serial.println() strings
+enum LogEvent : uint8_t {
+  LOG_BOOT = 1,
+  LOG_PRESSED_ONCE,
+  LOG_PRESSED_TWICE,
+  LOG_PRESSED_THRICE,
+  LOG_PRESSED_HOLD,
+  LOG_MODE,      // arg = new mode
+  LOG_MENU,      // arg = new menu
+  LOG_SHAKE,
+  LOG_GAME_OVER, // arg = score
+  LOG_REPLAY_DONE, // arg = ms of the last replayed edge
+  LOG_POWER,     // arg = new power state
+  LOG_BOOT_SPLASH, // arg = millis() when the splash was on the panel
+  LOG_FIRST_FRAME, // arg = millis() when the first animation frame was on the panel
+  LOG_BOOT_FAILED, // arg = 0 display, 1 MPU
+  LOG_FRAMES_DROPPED, // arg = frames skipped to keep the clip on time
+  LOG_ASSETS,    // arg = clips taken from the asset pack, -1 for a pack that does not fit
+};
+
+void telemetryBegin();
+bool telemetryWrite(uint8_t type, const void *payload, uint8_t len);
+void telemetryLog(uint8_t event, int32_t arg = 0);
+void telemetryDrain();
+void telemetryFlush();
@@ -0,0 +1,65 @@
+#include "tilt.h"
+#include <Wire.h>
+#include "pins.h"
+#include "profiler.h"
+#include "replay.h"
+
+#define TILT_FRACTION 4  // fixed point bits the filter keeps below a count
+
+static int32_t filtered[3];
+static bool primed = false;
+
+/**
+ * burst reads the three accelerometer axes, false when the MPU did not answer
+ */
+static bool readAccel(int16_t raw[3]) {
+  Wire.beginTransmission(MPU_I2C_ADDRESS);
+  Wire.write(MPU_ACCEL_XOUT_H);
+  if (Wire.endTransmission(false) != 0 || Wire.requestFrom((uint8_t)MPU_I2C_ADDRESS, (uint8_t)6) != 6) {
+    return false;
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    raw[i] = Wire.read() << 8;
+    raw[i] |= Wire.read();
+  }
+  return true;
+}
+
+/**
+ * reads the accelerometer and feeds the filter, false when the MPU did not
+ * answer and the filter kept its value. The raw sample goes through the
+ * replay hook like every other input, a replay takes it from the log and
+ * leaves the bus alone
+ */
+bool tiltSample() {
+  PROFILE_BEGIN(STAGE_TILT);
+  int16_t raw[3];
+  if (!REPLAYING && !readAccel(raw)) {
+    PROFILE_END(STAGE_TILT);
+    return false;
+  }
+  replayTilt(raw);
+  for (uint8_t i = 0; i < 3; i++) {
+    int32_t sample = (int32_t)raw[i] * (1 << TILT_FRACTION);
+    // the first sample starts the filter, no slow drift in from zero
+    filtered[i] = primed ? filtered[i] + ((sample - filtered[i]) >> TILT_FILTER_SHIFT) : sample;
+  }
+  primed = true;
+  PROFILE_END(STAGE_TILT);
+  return true;
+}
+
+/**
+ * the next sample restarts the filter
+ */
+void tiltReset() {
+  primed = false;
+}
+
+TiltVector tiltFiltered() {
+  TiltVector v;
+  v.x = filtered[0] >> TILT_FRACTION;
+  v.y = filtered[1] >> TILT_FRACTION;
+  v.z = filtered[2] >> TILT_FRACTION;
+  return v;
+}
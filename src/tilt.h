@@ -0,0 +1,25 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Fast accelerometer reads for modes that follow how the toy is held.
+
+   Adafruit_MPU6050::getEvent() reads all 14 sensor registers and converts
+   them to floats, fine for the 1 Hz shake poll but too slow for every frame.
+   tiltSample() burst reads just the 6 accelerometer bytes from
+   ACCEL_XOUT_H on, about 0.2 ms on the 400 kHz bus, and runs them through
+   a fixed-point low-pass filter. Values are raw counts, TILT_ONE_G per g at
+   the +-8 g range setup() picks.
+*/
+
+#define MPU_ACCEL_XOUT_H 0x3B
+#define TILT_ONE_G 4096
+#define TILT_FILTER_SHIFT 2  // a sample moves the filter 1/4 of the way
+
+struct TiltVector {
+  int16_t x, y, z;
+};
+
+bool tiltSample();
+void tiltReset();
+TiltVector tiltFiltered();
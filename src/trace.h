@@ -0,0 +1,47 @@
+#pragma once
+#include "telemetry.h"
+
+/**
+   Begin/end trace events for whole-system timing analysis.
+
+   Build with -DMAO_TRACE (the d1_mini_trace env) to record them, otherwise the
+   macros compile to nothing. Events travel through the telemetry ring, capture
+   them with tools/telemetry.py --save and convert with tools/trace_to_chrome.py,
+   then open the json in chrome://tracing or ui.perfetto.dev.
+   Keep the span ids in sync with tools/trace_to_chrome.py.
+*/
+
+enum TraceSpan : uint8_t {
+  TRACE_FRAME = 1,  // render of one frame, arg = mode
+  TRACE_FLUSH,      // display.display(), arg = pages sent
+  TRACE_MPU,        // MPU poll
+  TRACE_IRQ,        // IRQHandler(), arg = D5 level
+  TRACE_PAUSE,      // delayFrame() pause, arg = requested delay in ms
+  TRACE_MODE,       // time spent in a mode, arg = mode
+  TRACE_BUTTONS,    // button sequence processing, arg = amount of presses
+};
+
+enum TracePhase : uint8_t {
+  TRACE_PHASE_BEGIN = 'B',
+  TRACE_PHASE_END = 'E',
+  TRACE_PHASE_INSTANT = 'i',
+};
+
+#ifdef MAO_TRACE
+
+static inline void IRAM_ATTR traceEvent(uint8_t span, uint8_t phase, uint16_t arg) {
+  uint8_t payload[4] = { span, phase, (uint8_t)arg, (uint8_t)(arg >> 8) };
+  telemetryWrite(TLM_TRACE, payload, sizeof(payload));
+}
+
+#define TRACE_BEGIN(span, arg) traceEvent(span, TRACE_PHASE_BEGIN, arg)
+#define TRACE_END(span, arg) traceEvent(span, TRACE_PHASE_END, arg)
+#define TRACE_INSTANT(span, arg) traceEvent(span, TRACE_PHASE_INSTANT, arg)
+
+#else
+
+#define TRACE_BEGIN(span, arg)
+#define TRACE_END(span, arg)
+#define TRACE_INSTANT(span, arg)
+
+#endif
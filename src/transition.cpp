@@ -0,0 +1,278 @@
+#include "transition.h"
+#include "framebuffer.h"
+#include "render.h"
+#include "blit.h"
+#include "latency.h"
+
+#define IRIS_X (SCREEN_WIDTH / 2)
+#define IRIS_Y (SCREEN_HEIGHT / 2)
+
+#define DISSOLVE_LEVELS 64
+
+// 8x8 Bayer matrix by row, a pixel joins the incoming frame once the level passes it
+static const uint8_t bayer[8][8] = {
+  { 0, 32, 8, 40, 2, 34, 10, 42 },
+  { 48, 16, 56, 24, 50, 18, 58, 26 },
+  { 12, 44, 4, 36, 14, 46, 6, 38 },
+  { 60, 28, 52, 20, 62, 30, 54, 22 },
+  { 3, 35, 11, 43, 1, 33, 9, 41 },
+  { 51, 19, 59, 27, 49, 17, 57, 25 },
+  { 15, 47, 7, 39, 13, 45, 5, 37 },
+  { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+static uint8_t from[SCREEN_WIDTH * SCREEN_PAGES] __attribute__((aligned(4)));  // the outgoing frame
+
+static TransitionKind kind = TRANSITION_NONE;
+static uint16_t duration;
+static TransitionKind nextKind;  // armed, starts with the next frame
+static uint16_t nextDuration;
+static bool armed = false;
+static bool active = false;
+static bool started = false;  // the first incoming frame is there
+static unsigned long startTime;
+static unsigned long stepTime;
+static uint16_t level;   // progress in rows, columns, dither levels or iris radius
+static uint16_t levels;  // where it ends
+static uint8_t differing;  // pages where the two frames differ, one bit each
+
+static uint32_t dither[2];               // masks of 4 columns, for columns 0..3 and 4..7 of 8
+static int8_t irisHalf[SCREEN_WIDTH];   // rows above and below the center in the iris, -1 for none
+
+static uint16_t levelsOf(TransitionKind k) {
+  switch (k) {
+    case TRANSITION_WIPE: return SCREEN_HEIGHT;
+    case TRANSITION_SLIDE: return SCREEN_WIDTH;
+    case TRANSITION_DISSOLVE: return DISSOLVE_LEVELS;
+    default: {
+      // out to the corners
+      uint16_t r = 0;
+      while (r * r < IRIS_X * IRIS_X + IRIS_Y * IRIS_Y) {
+        r++;
+      }
+      return r;
+    }
+  }
+}
+
+// bits first..last of the screen's pages
+static uint8_t bitRange(int16_t first, int16_t last) {
+  return first > last ? 0 : (0xFF >> (7 - last)) & (0xFF << first);
+}
+
+
+
+/**
+ * works out the masks of the current level, once per step
+ */
+static void prepare() {
+  if (kind == TRANSITION_DISSOLVE) {
+    // page bytes of 4 neighbouring columns in a word, little endian
+    dither[0] = dither[1] = 0;
+    for (uint8_t x = 0; x < 8; x++) {
+      for (uint8_t row = 0; row < 8; row++) {
+        if (bayer[row][x] < level) {
+          dither[x / 4] |= (uint32_t)1 << ((x & 3) * 8 + row);
+        }
+      }
+    }
+  } else if (kind == TRANSITION_IRIS) {
+    // the half height shrinks away from the center, walk it down
+    int16_t half = level;
+    for (uint8_t dx = 0; dx <= IRIS_X; dx++) {
+      while (half >= 0 && half * half + dx * dx > level * level) {
+        half--;
+      }
+      if (IRIS_X + dx < SCREEN_WIDTH) {
+        irisHalf[IRIS_X + dx] = half;
+      }
+      if (dx) {
+        irisHalf[IRIS_X - dx] = half;
+      }
+    }
+  }
+}
+
+/**
+ * one page of the picture at the current level. out may be the outgoing
+ * page itself, every column only reads ahead of what it writes.
+ */
+static void compose(uint8_t page, const uint8_t *to, uint8_t *out) {
+  const uint8_t *old = from + page * SCREEN_WIDTH;
+  switch (kind) {
+    case TRANSITION_WIPE: {
+      uint8_t mask = rowMask(page, 0, level - 1);
+      for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+        out[x] = (to[x] & mask) | (old[x] & ~mask);
+      }
+      break;
+    }
+    case TRANSITION_SLIDE: {
+      uint8_t keep = SCREEN_WIDTH - level;  // columns of the old frame still showing
+      for (uint8_t x = 0; x < keep; x++) {
+        out[x] = old[x + level];
+      }
+      for (uint8_t x = keep; x < SCREEN_WIDTH; x++) {
+        out[x] = to[x - keep];
+      }
+      break;
+    }
+    case TRANSITION_DISSOLVE: {
+      // a word at a time, every buffer here is word aligned
+      const uint32_t *o = (const uint32_t *)old;
+      const uint32_t *t = (const uint32_t *)to;
+      uint32_t *w = (uint32_t *)out;
+      for (uint8_t i = 0; i < SCREEN_WIDTH / 4; i++) {
+        w[i] = o[i] ^ ((o[i] ^ t[i]) & dither[i & 1]);
+      }
+      break;
+    }
+    default:
+      for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+        uint8_t mask = rowMask(page, IRIS_Y - irisHalf[x], IRIS_Y + irisHalf[x]);
+        out[x] = (to[x] & mask) | (old[x] & ~mask);
+      }
+      break;
+  }
+}
+
+/**
+ * pages the step from level was to the current one changes, one bit each.
+ * Apart from the slide, pages without a difference never change.
+ */
+static uint8_t changedPages(uint16_t was) {
+  switch (kind) {
+    case TRANSITION_WIPE:
+      // only the band the edge moved over
+      return level == was ? 0 : bitRange(was / 8, (level - 1) / 8) & differing;
+    case TRANSITION_SLIDE:
+      return bitRange(0, SCREEN_PAGES - 1);
+    case TRANSITION_DISSOLVE:
+      return level ? differing : 0;
+    default:
+      return bitRange(max(IRIS_Y - level, 0) / 8, min(IRIS_Y + level, SCREEN_HEIGHT - 1) / 8) & differing;
+  }
+}
+
+// pages where the incoming frame differs from the outgoing one
+static uint8_t differingPages() {
+  uint8_t pages = 0;
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    const uint32_t *a = (const uint32_t *)(from + p * SCREEN_WIDTH);
+    const uint32_t *b = (const uint32_t *)(display.getBuffer() + p * SCREEN_WIDTH);
+    for (uint8_t i = 0; i < SCREEN_WIDTH / 4; i++) {
+      if (a[i] != b[i]) {
+        pages |= 1 << p;
+        break;
+      }
+    }
+  }
+  return pages;
+}
+
+/**
+ * composes and sends the pages as one flush, the framebuffer keeps the
+ * incoming frame. complete when this step shows all of the incoming frame
+ */
+static void sendPages(uint8_t pages, bool complete) {
+  uint8_t target[SCREEN_WIDTH] __attribute__((aligned(4)));
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    if (!(pages & (1 << p))) {
+      continue;
+    }
+    uint8_t *page = display.getBuffer() + p * SCREEN_WIDTH;
+    memcpy(target, page, SCREEN_WIDTH);
+    compose(p, target, page);
+    flushDisplayPart(p, p);
+    memcpy(page, target, SCREEN_WIDTH);
+  }
+  if (pages) {
+    flushPartsDone(complete);
+  } else if (complete) {
+    latencyFlushed(micros());  // the panel already showed the rest
+  }
+}
+
+// moves the level to where the time says it should be
+static void advance() {
+  stepTime = millis();
+  uint32_t elapsed = stepTime - startTime;
+  level = elapsed >= duration ? levels : elapsed * levels / duration;
+  prepare();
+}
+
+/**
+ * arms a transition to whatever the next frame draws
+ */
+void transitionStart(TransitionKind k, uint16_t time) {
+  nextKind = k;
+  nextDuration = time ? time : 1;
+  armed = k != TRANSITION_NONE;
+}
+
+bool transitionActive() {
+  return armed || active;
+}
+
+/**
+ * call before a frame is drawn, takes the picture on the panel as the
+ * outgoing frame when a transition is armed
+ */
+void transitionBeginFrame() {
+  if (!armed) {
+    return;
+  }
+  armed = false;
+  if (active && started) {
+    // cut short by another one, what the panel shows is the composition
+    for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+      compose(p, display.getBuffer() + p * SCREEN_WIDTH, from + p * SCREEN_WIDTH);
+    }
+  } else if (!active) {
+    memcpy(from, display.getBuffer(), sizeof(from));
+  }
+  kind = nextKind;
+  duration = nextDuration;
+  levels = levelsOf(kind);
+  active = true;
+  started = false;
+  level = 0;
+  differing = 0;
+}
+
+/**
+ * flushDisplay() for the frame loop, during a transition it only sends
+ * the pages of the new frame that are already showing
+ */
+void transitionFlush() {
+  if (!active) {
+    flushDisplay();
+    return;
+  }
+  if (!started) {
+    started = true;
+    startTime = millis();
+  }
+  advance();
+  // a page that stopped differing still shows a mix with the last frame
+  uint8_t now = differingPages();
+  differing |= now;
+  active = level < levels;
+  sendPages(changedPages(0), !active);
+  differing = now;
+}
+
+/**
+ * advances a running transition, call every loop()
+ */
+void transitionUpdate() {
+  if (!active || !started || millis() - stepTime < TRANSITION_STEP) {
+    return;
+  }
+  uint16_t was = level;
+  advance();
+  active = level < levels;
+  if (level != was) {
+    sendPages(changedPages(was), !active);
+  }
+}
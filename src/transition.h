@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+   Transitions between the frame on the panel and the next mode, driven by
+   time and sent page by page.
+
+   transitionStart() arms one. When the next frame starts, the picture on the
+   panel is kept as the outgoing frame, and the frames the modes draw from
+   then on are the incoming one: loop() hands them to transitionFlush()
+   instead of flushDisplay(), and transitionUpdate() moves the effect on
+   between frames. A step composes and sends only the pages it changes, the
+   framebuffer itself always holds the incoming frame, so the modes keep
+   drawing and timing their clips as usual. Pages where both frames are the
+   same are never sent, which keeps a dissolve between two clips of the face
+   down to the few pages around the eyes and mouth.
+*/
+
+#define TRANSITION_STEP 20   // ms between steps, at most 50 a second
+#define TRANSITION_TIME 300  // ms, what mode changes use
+
+enum TransitionKind : uint8_t {
+  TRANSITION_NONE,
+  TRANSITION_WIPE,      // top down
+  TRANSITION_SLIDE,     // in from the right, pushing the old frame out
+  TRANSITION_DISSOLVE,  // cross-fade through 64 ordered dither levels
+  TRANSITION_IRIS,      // a circle opening from the center
+};
+
+void transitionStart(TransitionKind kind, uint16_t duration);
+bool transitionActive();
+void transitionBeginFrame();
+void transitionFlush();
+void transitionUpdate();
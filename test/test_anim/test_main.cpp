@@ -0,0 +1,86 @@
+#include <unity.h>
+#include <host.h>
+#include "anim.h"
+
+#define RENDER_MS 25  // what drawing and flushing a frame takes
+
+// starts a frame and spends the render time on it
+static void renderFrame() {
+  TEST_ASSERT_TRUE(animDue());
+  animBeginFrame();
+  hostAdvance(RENDER_MS * 1000);
+}
+
+// ms from now until the next frame is due
+static uint32_t waitForFrame() {
+  unsigned long from = millis();
+  while (!animDue()) {
+    hostAdvance(1000);
+  }
+  return millis() - from;
+}
+
+void setUp() {
+  animBegin();
+  animReset();
+}
+
+void tearDown() {}
+
+void test_hold_counts_from_its_frame() {
+  renderFrame();
+  animHold(100);
+  TEST_ASSERT_EQUAL_UINT32(100 - RENDER_MS, waitForFrame());
+}
+
+void test_hold_after_unpaced_frames_is_full() {
+  // frames that set no hold, like the middle of a blink
+  for (uint8_t i = 0; i < 4; i++) {
+    renderFrame();
+  }
+  renderFrame();
+  animHold(100);
+  TEST_ASSERT_EQUAL_UINT32(100 - RENDER_MS, waitForFrame());
+  TEST_ASSERT_EQUAL(0, animLateFrames());
+}
+
+void test_hold_after_unpaced_frames_is_not_late() {
+  for (uint8_t i = 0; i < 4; i++) {
+    renderFrame();
+  }
+  renderFrame();
+  animHold(40);
+  waitForFrame();
+  animBeginFrame();
+  TEST_ASSERT_EQUAL(0, animLateFrames());
+}
+
+void test_held_frames_keep_a_fixed_rate() {
+  // a RENDER_MS render every 40 ms, the schedule does not drift by the render time
+  unsigned long start = millis();
+  for (uint8_t i = 0; i < 10; i++) {
+    renderFrame();
+    animHold(40);
+    waitForFrame();
+  }
+  TEST_ASSERT_EQUAL_UINT32(400, millis() - start);
+}
+
+void test_slow_frames_are_late() {
+  animBeginFrame();
+  animHold(20);
+  waitForFrame();
+  animBeginFrame();
+  hostAdvance(50 * 1000);
+  TEST_ASSERT_EQUAL(2, animLateFrames());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_hold_counts_from_its_frame);
+  RUN_TEST(test_hold_after_unpaced_frames_is_full);
+  RUN_TEST(test_hold_after_unpaced_frames_is_not_late);
+  RUN_TEST(test_held_frames_keep_a_fixed_rate);
+  RUN_TEST(test_slow_frames_are_late);
+  return UNITY_END();
+}
@@ -0,0 +1,328 @@
+#include <unity.h>
+#include <host.h>
+#include <unistd.h>
+#include <vector>
+#include "assets.h"
+#include "framebuffer.h"
+#include "render.h"
+
+/**
+   Packs written here the way tools/make_pack.py writes them, packBits() and
+   buildPack() follow its packbits() and build() step by step. A change to
+   the format has to go into both, and into loadFrame().
+*/
+
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+#define NAME_LENGTH 12
+
+typedef std::vector<uint8_t> Bytes;
+
+static char root[] = "/tmp/maotek_assetsXXXXXX";
+static byte builtinFrames[CLIP_COUNT];  // seen before there is a pack
+
+static void literals(Bytes &out, Bytes &literal) {
+  for (size_t at = 0; at < literal.size(); at += 128) {
+    size_t n = min(literal.size() - at, (size_t)128);
+    out.push_back(n - 1);
+    out.insert(out.end(), literal.begin() + at, literal.begin() + at + n);
+  }
+  literal.clear();
+}
+
+static Bytes packBits(const Bytes &data) {
+  Bytes out, literal;
+  size_t i = 0;
+  while (i < data.size()) {
+    size_t run = 1;
+    while (i + run < data.size() && run < 129 && data[i + run] == data[i]) {
+      run++;
+    }
+    if (run >= 2) {
+      literals(out, literal);
+      out.push_back(run + 126);
+      out.push_back(data[i]);
+      i += run;
+    } else {
+      literal.push_back(data[i++]);
+    }
+  }
+  literals(out, literal);
+  return out;
+}
+
+static void putU32(Bytes &out, uint32_t v) {
+  for (uint8_t i = 0; i < 4; i++) {
+    out.push_back(v >> 8 * i);
+  }
+}
+
+struct Clip {
+  const char *name;
+  std::vector<Bytes> frames;
+};
+
+static Bytes buildPack(const std::vector<Clip> &clips) {
+  uint32_t indexSize = 8 + clips.size() * (NAME_LENGTH + 6);
+  Bytes index = { 'M', 'P', 'A', 'K', ASSET_PACK_VERSION, SCREEN_WIDTH, SCREEN_HEIGHT, (uint8_t)clips.size() };
+  Bytes body;
+  for (const Clip &clip : clips) {
+    uint32_t tableAt = indexSize + body.size();
+    char name[NAME_LENGTH] = {};
+    strncpy(name, clip.name, NAME_LENGTH - 1);
+    index.insert(index.end(), name, name + NAME_LENGTH);
+    index.push_back(clip.frames.size());
+    index.push_back(clip.frames.size() >> 8);
+    putU32(index, tableAt);
+
+    std::vector<Bytes> encoded;
+    for (const Bytes &f : clip.frames) {
+      encoded.push_back(packBits(f));
+    }
+    uint32_t offset = tableAt + 4 * (clip.frames.size() + 1);
+    for (const Bytes &e : encoded) {
+      putU32(body, offset);
+      offset += e.size();
+    }
+    putU32(body, offset);
+    for (const Bytes &e : encoded) {
+      body.insert(body.end(), e.begin(), e.end());
+    }
+  }
+  index.insert(index.end(), body.begin(), body.end());
+  return index;
+}
+
+static void writePack(const Bytes &pack) {
+  std::string path = std::string(root) + ASSET_PACK_PATH;
+  FILE *f = fopen(path.c_str(), "wb");
+  TEST_ASSERT_NOT_NULL(f);
+  fwrite(pack.data(), 1, pack.size(), f);
+  fclose(f);
+}
+
+// the framebuffer bytes of a drawBitmap() frame, one pixel at a time
+static Bytes pageMajor(const uint8_t *bitmap) {
+  Bytes out(FRAME_BYTES);
+  for (uint16_t y = 0; y < SCREEN_HEIGHT; y++) {
+    for (uint16_t x = 0; x < SCREEN_WIDTH; x++) {
+      if (pgm_read_byte(&bitmap[y * (SCREEN_WIDTH / 8) + x / 8]) & (0x80 >> (x & 7))) {
+        out[y / 8 * SCREEN_WIDTH + x] |= 1 << (y & 7);
+      }
+    }
+  }
+  return out;
+}
+
+/**
+ * frames that take every path of the decoder: runs longer than one control
+ * byte, literals longer than one, a run that ends the frame and a literal
+ * that ends it
+ */
+static std::vector<Bytes> memeFrames() {
+  std::vector<Bytes> frames;
+  frames.push_back(Bytes(FRAME_BYTES, 0));
+
+  Bytes noise(FRAME_BYTES);
+  for (uint16_t i = 0; i < FRAME_BYTES; i++) {
+    noise[i] = i * 37 + (i >> 3);  // no two neighbours alike
+  }
+  frames.push_back(noise);
+
+  Bytes mixed(FRAME_BYTES);
+  for (uint16_t i = 0; i < FRAME_BYTES; i++) {
+    mixed[i] = i % 300 < 130 ? 0xAA : i * 13;
+  }
+  frames.push_back(mixed);
+
+  Bytes pairs(FRAME_BYTES);
+  for (uint16_t i = 0; i < FRAME_BYTES; i++) {
+    pairs[i] = i / 2;  // runs of two, the shortest run
+  }
+  frames.push_back(pairs);
+  return frames;
+}
+
+static uint32_t cacheHits() {
+  Serial.sent.clear();
+  assetsDump(Serial);
+  unsigned hits = 0;
+  const char *at = strstr(Serial.sent.c_str(), "cache hits ");
+  TEST_ASSERT_NOT_NULL(at);
+  sscanf(at, "cache hits %u", &hits);
+  return hits;
+}
+
+static void drawn(AssetClip clip, byte frame) {
+  display.clearDisplay();
+  assetDraw(clip, frame);
+}
+
+static void assertBuffer(const Bytes &expected) {
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), display.getBuffer(), FRAME_BYTES);
+}
+
+/**
+ * sends a frame the way loop() does, streaming or through the framebuffer,
+ * onto a panel that held something else
+ */
+static void shown(AssetClip clip, byte frame, bool stream) {
+  memset(panel.ram, 0x3C, FRAME_BYTES);
+  assetsStream(stream);
+  if (!stream) {
+    display.clearDisplay();
+  }
+  assetDraw(clip, frame);
+  assetsFlush();
+}
+
+// streamed frames on the panel are the framebuffer path's, and leaving
+// the stream puts them back into the framebuffer
+static void assertStreams(AssetClip clip, byte frame) {
+  static uint8_t expected[FRAME_BYTES];
+  shown(clip, frame, false);
+  memcpy(expected, panel.ram, FRAME_BYTES);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(display.getBuffer(), expected, FRAME_BYTES);
+
+  display.clearDisplay();
+  shown(clip, frame, true);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, panel.ram, FRAME_BYTES);
+  assetsStream(false);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_packbits_matches_make_pack() {
+  // the encodings make_pack.py gives for the same input
+  Bytes run(300, 7);
+  Bytes expected = { 129 + 126, 7, 129 + 126, 7, 42 + 126, 7 };
+  TEST_ASSERT_TRUE(packBits(run) == expected);
+
+  Bytes mixed = { 1, 2, 3, 3, 3, 4 };
+  expected = { 1, 1, 2, 3 + 126, 3, 0, 4 };
+  TEST_ASSERT_TRUE(packBits(mixed) == expected);
+
+  Bytes literal(200);
+  for (uint8_t i = 0; i < 200; i++) {
+    literal[i] = i;
+  }
+  Bytes encoded = packBits(literal);
+  TEST_ASSERT_EQUAL_UINT32(1 + 128 + 1 + 72, encoded.size());
+  TEST_ASSERT_EQUAL(127, encoded[0]);
+  TEST_ASSERT_EQUAL(71, encoded[129]);
+}
+
+void test_without_pack_draws_builtin() {
+  assetsBegin();
+  for (uint8_t c = 0; c < CLIP_COUNT; c++) {
+    AssetClip clip = (AssetClip)c;
+    builtinFrames[c] = assetFrames(clip);
+    byte last = builtinFrames[c] - 1;
+    drawn(clip, last);
+    assertBuffer(pageMajor(assetBitmap(clip, last)));
+  }
+}
+
+void test_builtin_frames_stream() {
+  for (uint8_t c = 0; c < CLIP_COUNT; c++) {
+    for (byte f = 0; f < assetFrames((AssetClip)c); f++) {
+      assertStreams((AssetClip)c, f);
+    }
+  }
+  // the framebuffer was left alone
+  display.clearDisplay();
+  shown(CLIP_BLINK, 0, true);
+  TEST_ASSERT_EACH_EQUAL_UINT8(0, display.getBuffer(), FRAME_BYTES);
+  assetsStream(false);
+}
+
+void test_pack_frames_round_trip() {
+  std::vector<Bytes> frames = memeFrames();
+  TEST_ASSERT_EQUAL(frames.size(), assetFrames(CLIP_MEMES));
+  for (uint8_t i = 0; i < frames.size(); i++) {
+    drawn(CLIP_MEMES, i);
+    assertBuffer(frames[i]);
+  }
+}
+
+void test_prefetched_frame_matches() {
+  std::vector<Bytes> frames = memeFrames();
+  drawn(CLIP_MEMES, 0);
+  assetsPrefetch();
+  uint32_t hits = cacheHits();
+  for (uint8_t i = 1; i <= 2 * frames.size(); i++) {
+    drawn(CLIP_MEMES, i % frames.size());
+    assertBuffer(frames[i % frames.size()]);
+    assetsPrefetch();
+  }
+  TEST_ASSERT_EQUAL_UINT32(2 * frames.size(), cacheHits() - hits);
+}
+
+void test_pack_frames_stream() {
+  // decoded into the framebuffer on a miss, sent from the cache on a hit
+  for (uint8_t i = 0; i < 2 * assetFrames(CLIP_MEMES); i++) {
+    assertStreams(CLIP_MEMES, i % assetFrames(CLIP_MEMES));
+    assetsPrefetch();
+  }
+  for (byte f = 0; f < builtinFrames[CLIP_BLINK]; f++) {
+    assertStreams(CLIP_BLINK, f);
+  }
+}
+
+void test_face_clip_needs_builtin_count() {
+  // the pack's one-frame blink is ignored, its sleep replaces the built-in
+  TEST_ASSERT_EQUAL(builtinFrames[CLIP_BLINK], assetFrames(CLIP_BLINK));
+  drawn(CLIP_BLINK, 0);
+  assertBuffer(pageMajor(assetBitmap(CLIP_BLINK, 0)));
+  drawn(CLIP_SLEEP, 1);
+  assertBuffer(Bytes(FRAME_BYTES, 0x81));
+}
+
+void test_broken_frame_falls_back() {
+  // the last sleep frame is cut short in the pack
+  byte last = builtinFrames[CLIP_SLEEP] - 1;
+  drawn(CLIP_SLEEP, last);
+  assertBuffer(pageMajor(assetBitmap(CLIP_SLEEP, last)));
+}
+
+/**
+ * the pack for the tests after assetsBegin() found none: the memes, a blink
+ * with the wrong frame count and a sleep with a truncated last frame
+ */
+static void packBegin() {
+  std::vector<Clip> clips;
+  clips.push_back({ "memes", memeFrames() });
+  clips.push_back({ "blink", { Bytes(FRAME_BYTES, 0xFF) } });
+  Clip sleep = { "sleep", {} };
+  for (uint8_t i = 0; i < builtinFrames[CLIP_SLEEP]; i++) {
+    sleep.frames.push_back(Bytes(FRAME_BYTES, 0x81));
+  }
+  clips.push_back(sleep);
+  Bytes pack = buildPack(clips);
+  pack.resize(pack.size() - 1);  // the last frame of sleep is the last thing in the pack
+  writePack(pack);
+  hostFsRoot(root);
+  assetsBegin();
+}
+
+int main() {
+  if (!mkdtemp(root)) {
+    return 1;
+  }
+  UNITY_BEGIN();
+  RUN_TEST(test_packbits_matches_make_pack);
+  RUN_TEST(test_without_pack_draws_builtin);
+  RUN_TEST(test_builtin_frames_stream);
+  packBegin();
+  RUN_TEST(test_pack_frames_round_trip);
+  RUN_TEST(test_prefetched_frame_matches);
+  RUN_TEST(test_pack_frames_stream);
+  RUN_TEST(test_face_clip_needs_builtin_count);
+  RUN_TEST(test_broken_frame_falls_back);
+  int failed = UNITY_END();
+  remove((std::string(root) + ASSET_PACK_PATH).c_str());
+  rmdir(root);
+  return failed;
+}
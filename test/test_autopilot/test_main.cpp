@@ -0,0 +1,77 @@
+#include <unity.h>
+#include "autopilot.h"
+#include "flappy.h"
+
+/**
+   The autopilot plays the real game, flappyLoop() with its physics, walls
+   and random gaps, for as long as a soak run would, and must not crash.
+*/
+
+#define SURVIVAL_FRAMES 50000L  // per seed, about 67 minutes of play at GAME_SPEED
+
+static FlappyGame *newGame(unsigned long seed) {
+  randomSeed(seed);
+  flappyEnter();
+  FlappyGame *game = flappyGame();
+  game->game_state = 1;
+  flappyLoop();  // the game over screen sets up the next game
+  game->game_state = 0;
+  return game;
+}
+
+void setUp() {}
+
+void tearDown() {
+  arenaLeave();
+}
+
+static void survives(unsigned long seed) {
+  FlappyGame *game = newGame(seed);
+  for (long frame = 0; frame < SURVIVAL_FRAMES; frame++) {
+    if (autopilotShouldFlap(*game)) {
+      game->momentum = -4;  // what a tap does, see buttonEdge()
+    }
+    flappyLoop();
+    if (game->game_state != 0) {
+      char message[64];
+      snprintf(message, sizeof(message), "crashed in frame %ld with score %d", frame, game->score);
+      TEST_FAIL_MESSAGE(message);
+    }
+  }
+  // a wall every 16 frames on average, the bird passed them
+  TEST_ASSERT_GREATER_THAN(SURVIVAL_FRAMES / 20, game->score);
+}
+
+void test_survives_seed_1() {
+  survives(1);
+}
+
+void test_survives_seed_2() {
+  survives(2);
+}
+
+void test_survives_seed_3() {
+  survives(3);
+}
+
+void test_survives_seed_4() {
+  survives(4);
+}
+
+void test_without_flaps_the_bird_crashes() {
+  FlappyGame *game = newGame(1);
+  for (int frame = 0; frame < 100 && game->game_state == 0; frame++) {
+    flappyLoop();
+  }
+  TEST_ASSERT_EQUAL(1, game->game_state);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_without_flaps_the_bird_crashes);
+  RUN_TEST(test_survives_seed_1);
+  RUN_TEST(test_survives_seed_2);
+  RUN_TEST(test_survives_seed_3);
+  RUN_TEST(test_survives_seed_4);
+  return UNITY_END();
+}
@@ -0,0 +1,174 @@
+#include <unity.h>
+#include "assets.h"
+#include "blit.h"
+#include "framebuffer.h"
+
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+
+static uint8_t expected[FRAME_BYTES];
+
+// what drawBitmap() leaves on a cleared framebuffer
+static void referenceFrame(const uint8_t *bitmap) {
+  display.clearDisplay();
+  display.drawBitmap(0, 0, bitmap, SCREEN_WIDTH, SCREEN_HEIGHT, WHITE);
+  memcpy(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+// every frame the firmware has built in
+static void eachFrame(void (*check)(const uint8_t *bitmap)) {
+  for (uint8_t c = 0; c < CLIP_COUNT; c++) {
+    for (byte f = 0; f < assetFrames((AssetClip)c); f++) {
+      check(assetBitmap((AssetClip)c, f));
+    }
+  }
+}
+
+void setUp() {
+  display.clearDisplay();
+}
+
+void tearDown() {}
+
+static void checkAligned(const uint8_t *bitmap) {
+  TEST_ASSERT_EQUAL_MESSAGE(0, (uintptr_t)bitmap & 3, "frames are declared aligned(4)");
+  referenceFrame(bitmap);
+  display.clearDisplay();
+  blitFrame(bitmap);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+void test_word_blit_matches_draw_bitmap() {
+  eachFrame(checkAligned);
+}
+
+static void checkBytes(const uint8_t *bitmap) {
+  referenceFrame(bitmap);
+  display.clearDisplay();
+  blitFrameBytes(bitmap);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+void test_byte_blit_matches_draw_bitmap() {
+  eachFrame(checkBytes);
+}
+
+static void checkUnaligned(const uint8_t *bitmap) {
+  static uint8_t shifted[FRAME_BYTES + 1] __attribute__((aligned(4)));
+  memcpy(shifted + 1, bitmap, FRAME_BYTES);
+  referenceFrame(bitmap);
+  display.clearDisplay();
+  blitFrame(shifted + 1);  // takes the byte-wise path
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+void test_unaligned_bitmap_falls_back() {
+  eachFrame(checkUnaligned);
+}
+
+void test_blit_ors_into_frame() {
+  const uint8_t *bitmap = assetBitmap(CLIP_BLINK, 0);
+  memset(display.getBuffer(), 0x5A, FRAME_BYTES);
+  display.drawBitmap(0, 0, bitmap, SCREEN_WIDTH, SCREEN_HEIGHT, WHITE);
+  memcpy(expected, display.getBuffer(), FRAME_BYTES);
+  memset(display.getBuffer(), 0x5A, FRAME_BYTES);
+  blitFrame(bitmap);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, display.getBuffer(), FRAME_BYTES);
+}
+
+void test_page_matches_frame() {
+  const uint8_t *bitmap = assetBitmap(CLIP_PETTING, 1);
+  blitFrame(bitmap);
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    uint8_t row[SCREEN_WIDTH] = {};
+    blitPage(bitmap, p, row);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(display.getBuffer() + p * SCREEN_WIDTH, row, SCREEN_WIDTH);
+  }
+}
+
+// the block one bit at a time: page byte c is column c, row 0 in the LSB
+static void referenceTranspose(const uint8_t rows[8], uint8_t columns[8]) {
+  memset(columns, 0, 8);
+  for (uint8_t r = 0; r < 8; r++) {
+    for (uint8_t c = 0; c < 8; c++) {
+      if (rows[r] & (0x80 >> c)) {
+        columns[c] |= 1 << r;
+      }
+    }
+  }
+}
+
+static void checkTranspose(const uint8_t rows[8]) {
+  uint32_t x = (uint32_t)rows[7] << 24 | rows[6] << 16 | rows[5] << 8 | rows[4];
+  uint32_t y = (uint32_t)rows[3] << 24 | rows[2] << 16 | rows[1] << 8 | rows[0];
+  transpose8(x, y);
+  uint8_t got[8] = { (uint8_t)(x >> 24), (uint8_t)(x >> 16), (uint8_t)(x >> 8), (uint8_t)x,
+                     (uint8_t)(y >> 24), (uint8_t)(y >> 16), (uint8_t)(y >> 8), (uint8_t)y };
+  uint8_t columns[8];
+  referenceTranspose(rows, columns);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(columns, got, 8);
+}
+
+void test_transpose_single_bits() {
+  for (uint8_t r = 0; r < 8; r++) {
+    for (uint8_t c = 0; c < 8; c++) {
+      uint8_t rows[8] = {};
+      rows[r] = 0x80 >> c;
+      checkTranspose(rows);
+    }
+  }
+}
+
+void test_transpose_random_blocks() {
+  randomSeed(42);
+  for (uint16_t i = 0; i < 10000; i++) {
+    uint8_t rows[8];
+    for (uint8_t r = 0; r < 8; r++) {
+      rows[r] = random(256);
+    }
+    checkTranspose(rows);
+  }
+}
+
+// the per-pixel conversion of a row-major bitmap
+static void referencePages(const uint8_t *bitmap, uint16_t width, uint16_t height, uint8_t *pages) {
+  uint16_t stride = width / 8;
+  memset(pages, 0, width * ((height + 7) / 8));
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      if (bitmap[y * stride + x / 8] & (0x80 >> (x & 7))) {
+        pages[y / 8 * width + x] |= 1 << (y & 7);
+      }
+    }
+  }
+}
+
+void test_bitmap_to_pages_any_height() {
+  // sprite sizes and short last pages, the padding has to stay blank
+  const uint16_t sizes[][2] = { { 8, 1 }, { 8, 8 }, { 16, 12 }, { 24, 17 }, { 32, 24 }, { 128, 64 }, { 40, 3 } };
+  static uint8_t bitmap[SCREEN_WIDTH / 8 * SCREEN_HEIGHT];
+  static uint8_t pages[FRAME_BYTES], reference[FRAME_BYTES];
+  randomSeed(7);
+  for (const uint16_t *size : sizes) {
+    uint16_t w = size[0], h = size[1];
+    for (uint16_t i = 0; i < w / 8 * h; i++) {
+      bitmap[i] = random(256);
+    }
+    memset(pages, 0xEE, sizeof(pages));
+    bitmapToPages(bitmap, w, h, pages);
+    referencePages(bitmap, w, h, reference);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(reference, pages, w * ((h + 7) / 8));
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_word_blit_matches_draw_bitmap);
+  RUN_TEST(test_byte_blit_matches_draw_bitmap);
+  RUN_TEST(test_unaligned_bitmap_falls_back);
+  RUN_TEST(test_blit_ors_into_frame);
+  RUN_TEST(test_page_matches_frame);
+  RUN_TEST(test_transpose_single_bits);
+  RUN_TEST(test_transpose_random_blocks);
+  RUN_TEST(test_bitmap_to_pages_any_height);
+  return UNITY_END();
+}
@@ -0,0 +1,89 @@
+#include <unity.h>
+#include <host.h>
+#include "arena.h"
+#include "eyes.h"
+#include "framebuffer.h"
+#include "render.h"
+#include "tilt.h"
+#include "transition.h"
+
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+#define FRAMES 500
+
+static uint8_t shown[FRAME_BYTES];
+
+// the first frame is drawn in full for the caller to flush
+static void enterLevel() {
+  hostAccel(0, 0, TILT_ONE_G);
+  eyesEnter();
+  TEST_ASSERT_TRUE(eyesFrame());
+  flushDisplay();
+}
+
+// a tilt anywhere up to about 45 degrees, lying flat or upside down
+static void randomTilt() {
+  int16_t x = random(-TILT_ONE_G * 3 / 4, TILT_ONE_G * 3 / 4);
+  int16_t y = random(-TILT_ONE_G * 3 / 4, TILT_ONE_G * 3 / 4);
+  hostAccel(x, y, random(2) ? TILT_ONE_G / 2 : -TILT_ONE_G / 2);
+}
+
+/**
+ * the whole face for the gaze on the panel: with the MPU off the bus the
+ * pupils stay put, and an armed transition makes the eyes draw everything
+ */
+static void fullRedraw() {
+  hostMpuOnline(false);
+  transitionStart(TRANSITION_WIPE, TRANSITION_TIME);
+  TEST_ASSERT_TRUE(eyesFrame());
+  transitionStart(TRANSITION_NONE, 0);
+  hostMpuOnline(true);
+}
+
+void setUp() {
+  memset(panel.ram, 0, sizeof(panel.ram));
+  randomSeed(47);
+}
+
+void tearDown() {
+  arenaLeave();
+}
+
+void test_partial_frames_match_full_redraw() {
+  enterLevel();
+  for (uint16_t i = 0; i < FRAMES; i++) {
+    randomTilt();
+    TEST_ASSERT_FALSE(eyesFrame());
+    memcpy(shown, panel.ram, FRAME_BYTES);
+    fullRedraw();
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(display.getBuffer(), shown, FRAME_BYTES);
+  }
+}
+
+void test_partial_frames_send_less() {
+  enterLevel();
+  uint32_t sent = panel.bytesSent;
+  for (uint16_t i = 0; i < FRAMES; i++) {
+    randomTilt();
+    eyesFrame();
+  }
+  uint32_t perFrame = (panel.bytesSent - sent) / FRAMES;
+  TEST_ASSERT_GREATER_THAN(0, perFrame);
+  TEST_ASSERT_LESS_THAN(FRAME_BYTES / 2, perFrame);
+}
+
+void test_still_eyes_send_nothing() {
+  enterLevel();
+  uint32_t sent = panel.bytesSent;
+  for (uint8_t i = 0; i < 10; i++) {
+    TEST_ASSERT_FALSE(eyesFrame());
+  }
+  TEST_ASSERT_EQUAL_UINT32(sent, panel.bytesSent);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_partial_frames_match_full_redraw);
+  RUN_TEST(test_partial_frames_send_less);
+  RUN_TEST(test_still_eyes_send_nothing);
+  return UNITY_END();
+}
@@ -0,0 +1,86 @@
+#include <unity.h>
+#include "histogram.h"
+
+static Histogram h;
+
+void setUp() {
+  histogramReset(h);
+}
+
+void tearDown() {}
+
+void test_small_values_are_exact() {
+  for (uint32_t v = 0; v < 16; v++) {
+    TEST_ASSERT_EQUAL(v, histogramBucket(v));
+  }
+}
+
+void test_buckets_grow_with_value() {
+  uint8_t last = 0;
+  for (uint32_t v = 1; v < 20000000; v += v / 64 + 1) {
+    uint8_t b = histogramBucket(v);
+    TEST_ASSERT_TRUE(b >= last);
+    TEST_ASSERT_TRUE(b <= last + 1);  // no bucket is skipped
+    TEST_ASSERT_LESS_THAN(HISTOGRAM_BUCKETS, b);
+    last = b;
+  }
+  TEST_ASSERT_EQUAL(HISTOGRAM_BUCKETS - 1, last);
+}
+
+void test_four_buckets_per_octave() {
+  TEST_ASSERT_EQUAL(16, histogramBucket(16));
+  TEST_ASSERT_EQUAL(16, histogramBucket(19));
+  TEST_ASSERT_EQUAL(17, histogramBucket(20));
+  TEST_ASSERT_EQUAL(19, histogramBucket(31));
+  TEST_ASSERT_EQUAL(20, histogramBucket(32));
+  // 1000 us is in [896, 1024)
+  TEST_ASSERT_EQUAL(histogramBucket(896), histogramBucket(1000));
+  TEST_ASSERT_EQUAL(histogramBucket(896) + 1, histogramBucket(1024));
+}
+
+void test_past_eight_seconds_is_last_bucket() {
+  // the last bucket starts at 7.3 s and takes everything above
+  TEST_ASSERT_LESS_THAN(HISTOGRAM_BUCKETS - 1, histogramBucket(7340031));
+  TEST_ASSERT_EQUAL(HISTOGRAM_BUCKETS - 1, histogramBucket(7340032));
+  TEST_ASSERT_EQUAL(HISTOGRAM_BUCKETS - 1, histogramBucket(1UL << 23));
+  TEST_ASSERT_EQUAL(HISTOGRAM_BUCKETS - 1, histogramBucket(0xFFFFFFFF));
+}
+
+void test_record_tracks_min_max_sum() {
+  histogramRecord(h, 300);
+  histogramRecord(h, 100);
+  histogramRecord(h, 200);
+  TEST_ASSERT_EQUAL_UINT32(3, h.count);
+  TEST_ASSERT_EQUAL_UINT32(100, h.min);
+  TEST_ASSERT_EQUAL_UINT32(300, h.max);
+  TEST_ASSERT_EQUAL_UINT32(600, h.sum);
+}
+
+void test_percentile_is_bucket_upper_bound() {
+  for (uint32_t v = 1; v <= 100; v++) {
+    histogramRecord(h, 1000 + v);  // all in [1024, 1280) but the first 23
+  }
+  uint32_t p50 = histogramPercentile(h, 50);
+  TEST_ASSERT_EQUAL(histogramBucket(1050), histogramBucket(p50));
+  TEST_ASSERT_TRUE(p50 >= 1050);
+  TEST_ASSERT_EQUAL_UINT32(1100, histogramPercentile(h, 99));  // clamped to the max
+}
+
+void test_percentile_past_range_is_max() {
+  histogramRecord(h, 20000000);
+  TEST_ASSERT_EQUAL_UINT32(20000000, histogramPercentile(h, 50));
+  histogramReset(h);
+  TEST_ASSERT_EQUAL_UINT32(0, histogramPercentile(h, 50));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_small_values_are_exact);
+  RUN_TEST(test_buckets_grow_with_value);
+  RUN_TEST(test_four_buckets_per_octave);
+  RUN_TEST(test_past_eight_seconds_is_last_bucket);
+  RUN_TEST(test_record_tracks_min_max_sum);
+  RUN_TEST(test_percentile_is_bucket_upper_bound);
+  RUN_TEST(test_percentile_past_range_is_max);
+  return UNITY_END();
+}
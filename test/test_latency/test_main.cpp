@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <host.h>
+#include "framebuffer.h"
+#include "latency.h"
+#include "render.h"
+
+/**
+   The probe on the host clock, run with `pio test -e native_latency`: a
+   press is measured from its edge to the end of the flush of the first
+   frame that started after it was acted on.
+*/
+
+#ifndef MAO_LATENCY
+#error "test_latency needs -DMAO_LATENCY, the native_latency env"
+#endif
+
+// the line of the dump for a gesture, "flap n=1 min=..."
+static std::string dumped(const char *gesture) {
+  Serial.sent.clear();
+  latencyDump(Serial);
+  size_t at = Serial.sent.find(std::string(gesture) + " n=");
+  TEST_ASSERT_TRUE(at != std::string::npos);
+  return Serial.sent.substr(at, Serial.sent.find('\n', at) - at);
+}
+
+static void assertLatency(const char *gesture, uint32_t count, uint32_t min, uint32_t max) {
+  char expected[80];
+  snprintf(expected, sizeof(expected), "%s n=%u min=%u", gesture, count, min);
+  std::string line = dumped(gesture);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, line.substr(0, strlen(expected)).c_str(), line.c_str());
+  snprintf(expected, sizeof(expected), " max=%u us", max);
+  TEST_ASSERT_TRUE_MESSAGE(line.find(expected) != std::string::npos, line.c_str());
+}
+
+// one frame: it starts, takes drawMicros to draw and is flushed
+static void frame(uint32_t drawMicros) {
+  latencyFrameBegin();
+  hostAdvance(drawMicros);
+  flushDisplay();
+}
+
+void setUp() {
+  latencyReset();
+}
+
+void tearDown() {}
+
+void test_edge_to_end_of_flush() {
+  uint32_t edge = micros();
+  hostAdvance(1200);  // the press waits for loop() to act on it
+  latencyPending(GESTURE_FLAP, edge);
+  hostAdvance(3000);
+  frame(4500);
+  assertLatency("flap", 1, 1200 + 3000 + 4500, 1200 + 3000 + 4500);
+}
+
+void test_frame_already_rendering_does_not_count() {
+  latencyFrameBegin();
+  uint32_t edge = micros();
+  latencyPending(GESTURE_ONCE, edge);
+  hostAdvance(2000);
+  flushDisplay();  // began before the press
+  assertLatency("once", 0, 0, 0);
+  frame(5000);
+  assertLatency("once", 1, 7000, 7000);
+}
+
+void test_oldest_press_is_measured() {
+  uint32_t first = micros();
+  latencyPending(GESTURE_TWICE, first);
+  hostAdvance(10000);
+  latencyPending(GESTURE_TWICE, micros());
+  frame(1000);
+  assertLatency("twice", 1, 11000, 11000);
+}
+
+void test_gestures_are_separate() {
+  uint32_t edge = micros();
+  latencyPending(GESTURE_FLAP, edge);
+  hostAdvance(500);
+  latencyPending(GESTURE_HOLD, micros());
+  frame(2000);
+  assertLatency("flap", 1, 2500, 2500);
+  assertLatency("hold", 1, 2000, 2000);
+  assertLatency("twice", 0, 0, 0);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_edge_to_end_of_flush);
+  RUN_TEST(test_frame_already_rendering_does_not_count);
+  RUN_TEST(test_oldest_press_is_measured);
+  RUN_TEST(test_gestures_are_separate);
+  return UNITY_END();
+}
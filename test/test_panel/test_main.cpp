@@ -0,0 +1,79 @@
+#include <unity.h>
+#include "framebuffer.h"
+#include "render.h"
+
+// pages of the panel and the framebuffer, one byte per column
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+
+static void fillPattern(uint8_t *b, uint8_t seed) {
+  for (uint16_t i = 0; i < FRAME_BYTES; i++) {
+    b[i] = i * 7 + seed;
+  }
+}
+
+void setUp() {
+  memset(panel.ram, 0, sizeof(panel.ram));
+  display.clearDisplay();
+  flushDisplay();
+}
+
+void tearDown() {}
+
+void test_full_flush_reaches_panel() {
+  fillPattern(display.getBuffer(), 3);
+  uint32_t sent = panel.bytesSent;
+  flushDisplay();
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(display.getBuffer(), panel.ram, FRAME_BYTES);
+  TEST_ASSERT_EQUAL_UINT32(FRAME_BYTES, panel.bytesSent - sent);
+}
+
+void test_window_only_touches_window() {
+  fillPattern(display.getBuffer(), 5);
+  uint32_t sent = panel.bytesSent;
+  flushDisplayWindow(1, 2, 10, 19);
+  TEST_ASSERT_EQUAL_UINT32(2 * 10, panel.bytesSent - sent);
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+      bool inside = p >= 1 && p <= 2 && x >= 10 && x <= 19;
+      uint16_t i = p * SCREEN_WIDTH + x;
+      TEST_ASSERT_EQUAL_HEX8(inside ? display.getBuffer()[i] : 0, panel.ram[i]);
+    }
+  }
+}
+
+static const uint8_t *patternPage(uint8_t page, uint8_t *row) {
+  for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+    row[x] = page ^ x;
+  }
+  return row;
+}
+
+void test_stream_matches_its_pages() {
+  uint32_t count = flushCount;
+  flushStream(patternPage);
+  TEST_ASSERT_EQUAL_UINT32(1, flushCount - count);
+  for (uint8_t p = 0; p < SCREEN_PAGES; p++) {
+    for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+      TEST_ASSERT_EQUAL_HEX8(p ^ x, panel.ram[p * SCREEN_WIDTH + x]);
+    }
+  }
+}
+
+void test_commands_do_not_touch_ram() {
+  fillPattern(display.getBuffer(), 9);
+  flushDisplay();
+  const uint8_t scroll[] = { SSD1306_LEFT_HORIZONTAL_SCROLL, 0, 0, 0, 7, 0, 0xFF, SSD1306_ACTIVATE_SCROLL };
+  panel.commands(scroll, sizeof(scroll));
+  panel.command(SSD1306_SETCONTRAST);
+  panel.command(0x10);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(display.getBuffer(), panel.ram, FRAME_BYTES);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_flush_reaches_panel);
+  RUN_TEST(test_window_only_touches_window);
+  RUN_TEST(test_stream_matches_its_pages);
+  RUN_TEST(test_commands_do_not_touch_ram);
+  return UNITY_END();
+}
@@ -0,0 +1,106 @@
+#include <unity.h>
+#include <host.h>
+#include "framebuffer.h"
+#include "render.h"
+#include "transition.h"
+
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_PAGES)
+#define DISSOLVE_TIME 640  // ms, 10 per dither level
+
+// the order pixels of an 8x8 block switch over in, as in transition.cpp
+static const uint8_t bayer[8][8] = {
+  { 0, 32, 8, 40, 2, 34, 10, 42 },
+  { 48, 16, 56, 24, 50, 18, 58, 26 },
+  { 12, 44, 4, 36, 14, 46, 6, 38 },
+  { 60, 28, 52, 20, 62, 30, 54, 22 },
+  { 3, 35, 11, 43, 1, 33, 9, 41 },
+  { 51, 19, 59, 27, 49, 17, 57, 25 },
+  { 15, 47, 7, 39, 13, 45, 5, 37 },
+  { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+static bool lit(uint8_t x, uint8_t y) {
+  return panel.ram[y / 8 * SCREEN_WIDTH + x] & (1 << (y & 7));
+}
+
+// pixels of the incoming frame in the first block, -1 unless every block
+// shows the same ordered dither level
+static int8_t ditherLevel() {
+  uint8_t level = 0;
+  for (uint8_t y = 0; y < 8; y++) {
+    for (uint8_t x = 0; x < 8; x++) {
+      level += lit(x, y);
+    }
+  }
+  for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+    for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+      if (lit(x, y) != (bayer[y & 7][x & 7] < level)) {
+        return -1;
+      }
+    }
+  }
+  return level;
+}
+
+// a black panel, then a dissolve to what draw() leaves in the framebuffer
+static void startDissolve(void (*draw)()) {
+  display.clearDisplay();
+  flushDisplay();
+  transitionStart(TRANSITION_DISSOLVE, DISSOLVE_TIME);
+  transitionBeginFrame();
+  draw();
+  transitionFlush();
+}
+
+static void allWhite() {
+  memset(display.getBuffer(), 0xFF, FRAME_BYTES);
+}
+
+static void bottomHalfWhite() {
+  memset(display.getBuffer() + FRAME_BYTES / 2, 0xFF, FRAME_BYTES / 2);
+}
+
+void setUp() {}
+
+void tearDown() {
+  while (transitionActive()) {
+    hostAdvance(TRANSITION_STEP * 1000);
+    transitionUpdate();
+  }
+}
+
+void test_dissolve_steps_through_ordered_levels() {
+  startDissolve(allWhite);
+  int8_t last = ditherLevel();
+  TEST_ASSERT_EQUAL(0, last);
+  uint8_t steps = 0;
+  while (transitionActive()) {
+    hostAdvance(TRANSITION_STEP * 1000);
+    transitionUpdate();
+    int8_t level = ditherLevel();
+    TEST_ASSERT_GREATER_THAN(last, level);  // a pixel that switched stays switched
+    last = level;
+    steps++;
+  }
+  TEST_ASSERT_EQUAL(64, last);
+  TEST_ASSERT_EQUAL(DISSOLVE_TIME / TRANSITION_STEP, steps);
+}
+
+void test_dissolve_skips_equal_pages() {
+  // the top half is black in both frames, every step only sends the bottom
+  startDissolve(bottomHalfWhite);
+  while (transitionActive()) {
+    uint32_t sent = panel.bytesSent;
+    hostAdvance(TRANSITION_STEP * 1000);
+    transitionUpdate();
+    TEST_ASSERT_EQUAL_UINT32(FRAME_BYTES / 2, panel.bytesSent - sent);
+  }
+  TEST_ASSERT_EACH_EQUAL_UINT8(0xFF, panel.ram + FRAME_BYTES / 2, FRAME_BYTES / 2);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_dissolve_steps_through_ordered_levels);
+  RUN_TEST(test_dissolve_skips_equal_pages);
+  return UNITY_END();
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Report the RAM each mode takes in the mode arena (see src/arena.h).
+
+Every mode state is declared with ARENA_REPORT(), which puts an absolute
+symbol arena_<name> holding sizeof the state into the ELF. This script lists
+them next to the size of the arena block, the peak is what the block has to
+hold and anything above it is headroom for the next mode.
+
+PlatformIO runs it for every env as a post script once the firmware is
+linked. It also runs on its own:
+
+    python tools/arena_report.py .pio/build/d1_mini/firmware.elf --nm xtensa-lx106-elf-nm
+"""
+import argparse
+import subprocess
+import sys
+
+PREFIX = "arena_"
+BLOCK = "arena"
+
+
+def read_sizes(elf, nm):
+    """mode name to state size, and the size of the block itself"""
+    out = subprocess.run([nm, "-S", elf], check=True, capture_output=True, text=True).stdout
+    modes = {}
+    block = None
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[1] == "A" and fields[2].startswith(PREFIX):
+            modes[fields[2][len(PREFIX):]] = int(fields[0], 16)
+        elif len(fields) == 4 and fields[3] == BLOCK:
+            block = int(fields[1], 16)
+    return modes, block
+
+
+def report(modes, block):
+    if block is None:
+        return "arena: not linked"
+    lines = []
+    peak = max(modes.values(), default=0)
+    lines.append("arena: %d bytes, peak %d, %d free" % (block, peak, block - peak))
+    for name, size in sorted(modes.items(), key=lambda m: -m[1]):
+        lines.append("  %-10s %4d" % (name, size))
+    return "\n".join(lines)
+
+
+def pio_main(env):
+    nm = env.subst("$CC").replace("gcc", "nm")
+
+    def after_link(target, source, env):
+        print(report(*read_sizes(str(target[0]), nm)))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", after_link)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf")
+    parser.add_argument("--nm", default="nm")
+    args = parser.parse_args()
+    print(report(*read_sizes(args.elf, args.nm)))
+    return 0
+
+
+try:
+    Import("env")  # noqa: F821, only defined inside PlatformIO
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main())
+else:
+    pio_main(env)  # noqa: F821
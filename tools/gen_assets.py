@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Generate the frame headers for the panel geometry of a build.
+
+The bitmaps in include/ are drawn once at 128x64 (drawBitmap layout: row-major,
+MSB is the leftmost pixel). This script resamples every full-screen array in
+them to SCREEN_WIDTH x SCREEN_HEIGHT and writes headers with the same names
+into the build directory, which goes in front of include/ on the include path.
+Shrinking ORs the pixels a target pixel covers so thin outlines survive,
+growing repeats pixels. Other headers (scenario.h) are left alone.
+
+PlatformIO runs it for every env as a pre script and takes the geometry from
+the build flags, e.g. -DSCREEN_HEIGHT=32. Headers are only rewritten when their
+content changes, so unchanged assets do not trigger rebuilds.
+
+It also runs on its own, to look at a variant before flashing it:
+
+    python tools/gen_assets.py --width 128 --height 32 --out /tmp/assets
+"""
+import argparse
+import os
+import re
+import sys
+
+SOURCE_WIDTH = 128
+SOURCE_HEIGHT = 64
+FRAME_BYTES = SOURCE_WIDTH * SOURCE_HEIGHT // 8
+
+DECLARATION = re.compile(
+    r"const\s+unsigned\s+char\s+(\w+)\s*((?:\[\s*\d+\s*\]\s*)+)PROGMEM[^=]*=\s*\{")
+
+
+def unpack(frame, width, height):
+    """row-major bitmap bytes to rows of 0/1"""
+    stride = width // 8
+    return [[(frame[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+            for y in range(height)]
+
+
+def pack(pixels):
+    out = bytearray()
+    for row in pixels:
+        for x in range(0, len(row), 8):
+            byte = 0
+            for bit in row[x:x + 8]:
+                byte = byte << 1 | bit
+            out.append(byte)
+    return bytes(out)
+
+
+def resample(frame, width, height):
+    if (width, height) == (SOURCE_WIDTH, SOURCE_HEIGHT):
+        return bytes(frame)
+    src = unpack(frame, SOURCE_WIDTH, SOURCE_HEIGHT)
+    out = []
+    for y in range(height):
+        y0 = y * SOURCE_HEIGHT // height
+        y1 = max(y0 + 1, (y + 1) * SOURCE_HEIGHT // height)
+        row = []
+        for x in range(width):
+            x0 = x * SOURCE_WIDTH // width
+            x1 = max(x0 + 1, (x + 1) * SOURCE_WIDTH // width)
+            row.append(int(any(src[sy][sx] for sy in range(y0, y1) for sx in range(x0, x1))))
+        out.append(row)
+    return pack(out)
+
+
+def initializer(frames, dims, width, height):
+    """braced lines for frames laid out as the array dims around them"""
+    if not dims:
+        body = resample(frames[0], width, height)
+        return ["\t" + ", ".join("0x%02x" % b for b in body[i:i + 16]) + "," for i in range(0, len(body), 16)]
+    lines = []
+    step = len(frames) // dims[0]
+    for i in range(dims[0]):
+        lines.append("{")
+        lines.extend(initializer(frames[i * step:(i + 1) * step], dims[1:], width, height))
+        lines.append("},")
+    return lines
+
+
+def parse(text):
+    """yields (name, dims, frames, start, end) for every full-screen array in text"""
+    for m in DECLARATION.finditer(text):
+        dims = [int(d) for d in re.findall(r"\d+", m.group(2))]
+        if dims[-1] != FRAME_BYTES:
+            continue
+        end = text.index("};", m.end())
+        data = [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{2}", text[m.end():end])]
+        frames = [data[i:i + FRAME_BYTES] for i in range(0, len(data), FRAME_BYTES)]
+        yield m.group(1), dims, frames, m.start(), end + 2
+
+
+def convert(text, width, height):
+    """returns the generated header for text, None when it has no frames"""
+    found = False
+    out = []
+    pos = 0
+    for name, dims, frames, start, end in parse(text):
+        # #defines and such between the arrays are kept as they are
+        out.append(re.sub(r"//[^\n]*", "", text[pos:start]).strip())
+        frame_bytes = width * height // 8
+        shape = "".join("[%d]" % d for d in dims[:-1]) + "[%d]" % frame_bytes
+        # aligned for the 32-bit flash loads in blit.cpp
+        out.append("const unsigned char %s%s PROGMEM __attribute__((aligned(4))) = {" % (name, shape))
+        out.extend(initializer(frames, dims[:-1], width, height))
+        out.append("};")
+        pos = end
+        found = True
+
+    if not found:
+        return None
+    header = "// generated by tools/gen_assets.py for %dx%d, edit the 128x64 original in include/\n" % (width, height)
+    return header + "\n".join(line for line in out if line) + "\n"
+
+
+def generate(source_dir, out_dir, width, height):
+    if width % 8 or height % 8:
+        sys.exit("gen_assets: %dx%d is not a whole number of bytes and pages" % (width, height))
+    os.makedirs(out_dir, exist_ok=True)
+    written = 0
+    for name in sorted(os.listdir(source_dir)):
+        if not name.endswith(".h"):
+            continue
+        with open(os.path.join(source_dir, name)) as f:
+            header = convert(f.read(), width, height)
+        if header is None:
+            continue
+        path = os.path.join(out_dir, name)
+        if os.path.exists(path):
+            with open(path) as f:
+                if f.read() == header:
+                    continue
+        with open(path, "w") as f:
+            f.write(header)
+        written += 1
+    return written
+
+
+def pio_main(env):
+    defines = {}
+    for d in env.ParseFlags(env.get("BUILD_FLAGS", []))["CPPDEFINES"]:
+        if isinstance(d, (list, tuple)):
+            defines[d[0]] = d[1]
+        else:
+            defines[d] = None
+    width = int(defines.get("SCREEN_WIDTH") or SOURCE_WIDTH)
+    height = int(defines.get("SCREEN_HEIGHT") or SOURCE_HEIGHT)
+
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "assets")
+    written = generate(os.path.join(env.subst("$PROJECT_DIR"), "include"), out_dir, width, height)
+    if written:
+        print("gen_assets: %d headers for %dx%d" % (written, width, height))
+    env.Prepend(CPPPATH=[out_dir])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--width", type=int, default=SOURCE_WIDTH)
+    parser.add_argument("--height", type=int, default=SOURCE_HEIGHT)
+    parser.add_argument("--source", default=os.path.join(os.path.dirname(__file__), "..", "include"))
+    parser.add_argument("--out", required=True)
+    args = parser.parse_args()
+    written = generate(args.source, args.out, args.width, args.height)
+    print("%d headers for %dx%d in %s" % (written, args.width, args.height, args.out))
+
+
+try:
+    Import("env")  # noqa: F821, only defined inside PlatformIO
+except NameError:
+    if __name__ == "__main__":
+        main()
+else:
+    pio_main(env)  # noqa: F821
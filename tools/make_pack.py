@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Build an asset pack for LittleFS, see src/assets.h for the format.
+
+By default the pack holds every clip from the frame headers in include/,
+resampled to the panel size like tools/gen_assets.py does. Clips can be
+replaced or added from images (needs Pillow), one image per frame:
+
+    python tools/make_pack.py data/assets.pak
+    python tools/make_pack.py data/assets.pak --clip memes art/memes/*.png
+    python tools/make_pack.py data/assets.pak --height 32 --only memes --clip memes art/*.png
+
+Upload it with `pio run -t uploadfs`. The firmware takes a face clip only with
+its built-in frame count, the memes can have any number of frames.
+"""
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from gen_assets import SOURCE_HEIGHT, SOURCE_WIDTH, parse, resample  # noqa: E402
+
+VERSION = 1
+NAME_LENGTH = 12
+
+
+def page_major(bitmap, width, height):
+    """drawBitmap rows to framebuffer pages, LSB is the top pixel"""
+    stride = width // 8
+    out = bytearray(width * height // 8)
+    for y in range(height):
+        for x in range(width):
+            if bitmap[y * stride + x // 8] >> (7 - x % 8) & 1:
+                out[y // 8 * width + x] |= 1 << (y % 8)
+    return bytes(out)
+
+
+def packbits(data):
+    """n < 128: n + 1 literal bytes follow, n >= 128: next byte n - 126 times"""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            while literal:
+                out.append(len(literal[:128]) - 1)
+                out += literal[:128]
+                literal = literal[128:]
+            out += bytes((run + 126, data[i]))
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    while literal:
+        out.append(len(literal[:128]) - 1)
+        out += literal[:128]
+        literal = literal[128:]
+    return bytes(out)
+
+
+def unpackbits(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        n = data[i]
+        if n < 128:
+            out += data[i + 1:i + 2 + n]
+            i += n + 2
+        else:
+            out += bytes([data[i + 1]]) * (n - 126)
+            i += 2
+    return bytes(out)
+
+
+def header_clips(include_dir, width, height):
+    """(name, frames) from the headers, arrays of several clips get an index"""
+    clips = []
+    for name in sorted(os.listdir(include_dir)):
+        if not name.endswith(".h"):
+            continue
+        with open(os.path.join(include_dir, name)) as f:
+            text = f.read()
+        for array, dims, frames, _, _ in parse(text):
+            frames = [page_major(resample(f, width, height), width, height) for f in frames]
+            if len(dims) <= 2:
+                clips.append((array, frames))
+            else:
+                step = len(frames) // dims[0]
+                for i in range(dims[0]):
+                    clips.append(("%s%d" % (array, i), frames[i * step:(i + 1) * step]))
+    return clips
+
+
+def image_frames(paths, width, height):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("make_pack: --clip needs Pillow (pip install pillow)")
+    frames = []
+    for path in paths:
+        image = Image.open(path).convert("L")
+        if image.size != (width, height):
+            sys.exit("make_pack: %s is %dx%d, the panel is %dx%d" % ((path,) + image.size + (width, height)))
+        pixels = image.load()
+        frame = bytearray(width * height // 8)
+        for y in range(height):
+            for x in range(width):
+                if pixels[x, y] >= 128:
+                    frame[y // 8 * width + x] |= 1 << (y % 8)
+        frames.append(bytes(frame))
+    return frames
+
+
+def build(clips, width, height):
+    index_size = 8 + len(clips) * (NAME_LENGTH + 6)
+    index = bytearray(b"MPAK" + bytes((VERSION, width, height, len(clips))))
+    body = bytearray()
+    for name, frames in clips:
+        encoded = [packbits(f) for f in frames]
+        table_at = index_size + len(body)
+        index += name.encode()[:NAME_LENGTH - 1].ljust(NAME_LENGTH, b"\0")
+        index += struct.pack("<HI", len(frames), table_at)
+
+        offset = table_at + 4 * (len(frames) + 1)
+        for e in encoded:
+            body += struct.pack("<I", offset)
+            offset += len(e)
+        body += struct.pack("<I", offset)
+        for e in encoded:
+            body += e
+    return bytes(index + body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("output")
+    parser.add_argument("--width", type=int, default=SOURCE_WIDTH)
+    parser.add_argument("--height", type=int, default=SOURCE_HEIGHT)
+    parser.add_argument("--include", default=os.path.join(os.path.dirname(__file__), "..", "include"))
+    parser.add_argument("--clip", nargs="+", action="append", default=[], metavar=("NAME", "IMAGE"),
+                        help="replace or add a clip, one image per frame")
+    parser.add_argument("--only", nargs="+", metavar="NAME", help="keep only these clips")
+    args = parser.parse_args()
+
+    clips = dict(header_clips(args.include, args.width, args.height))
+    for name, *paths in args.clip:
+        clips[name] = image_frames(paths, args.width, args.height)
+    if args.only:
+        clips = {name: clips[name] for name in args.only if name in clips}
+
+    pack = build(list(clips.items()), args.width, args.height)
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "wb") as f:
+        f.write(pack)
+
+    raw = sum(len(frames) for frames in clips.values()) * args.width * args.height // 8
+    print("%s: %d clips, %d bytes (%d raw, %.0f%%)" % (args.output, len(clips), len(pack), raw, 100.0 * len(pack) / raw))
+    for name, frames in clips.items():
+        for f in frames:
+            assert unpackbits(packbits(f), len(f)) == f
+        print("  %-12s %3d frames" % (name, len(frames)))
+
+
+if __name__ == "__main__":
+    main()
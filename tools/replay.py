@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+Record/replay logs for MaoMao (see src/replay.h).
+
+    python tools/replay.py extract session.bin -o run.mrec    inputs from a -DMAO_RECORD capture
+    python tools/replay.py synth flappy --minutes 5 -o run.mrec
+    python tools/replay.py dump run.mrec
+    python tools/replay.py header run.mrec                    writes include/scenario.h for -DMAO_REPLAY
+
+Synthetic scenarios: idle, petting, shake, flappy.
+"""
+import argparse
+import random
+import struct
+import sys
+
+from telemetry import read_records
+
+MAGIC = b"MREC"
+VERSION = 2
+
+EDGE_LOW = 0
+EDGE_HIGH = 1
+MPU = 2
+WAIT = 3
+SEED = 4
+TILT = 5
+
+PAYLOAD = {MPU: 12, TILT: 6}  # bytes after the entry header, the rest have none
+
+TLM_INPUT = 4
+
+MPU_INTERVAL = 1000  # MPU_POLLING_INTERVAL in src/main.cpp
+SPLASH = 3000        # SPLASH_TIMER in src/main.cpp, a gesture before that only skips the splash
+GRAVITY = 9.8
+
+
+class Log:
+    def __init__(self, seed=1):
+        self.seed = seed
+        self.entries = []  # (ms, kind, payload)
+
+    def edge(self, ms, level):
+        self.entries.append((ms, EDGE_HIGH if level else EDGE_LOW, b""))
+
+    def mpu(self, ms, x, y, z):
+        self.entries.append((ms, MPU, struct.pack("<3f", x, y, z)))
+
+    def tilt(self, ms, x, y, z):
+        self.entries.append((ms, TILT, struct.pack("<3h", x, y, z)))
+
+    def tap(self, ms, length=80):
+        self.edge(ms, 1)
+        self.edge(ms + length, 0)
+
+    def encode(self):
+        out = bytearray(MAGIC + struct.pack("<BI", VERSION, self.seed))
+        now = 0
+        for ms, kind, payload in sorted(self.entries, key=lambda e: e[0]):
+            delta = ms - now
+            while delta > 0xFFFF:
+                out += struct.pack("<BH", WAIT, 0xFFFF)
+                delta -= 0xFFFF
+            out += struct.pack("<BH", kind, delta) + payload
+            now = ms
+        return bytes(out)
+
+    @staticmethod
+    def decode(data):
+        # version 1 logs are the same without tilt samples
+        if data[:4] != MAGIC or data[4] not in (1, VERSION):
+            raise ValueError("not a version %d replay log" % VERSION)
+        log = Log(struct.unpack_from("<I", data, 5)[0])
+        pos, now = 9, 0
+        while pos < len(data):
+            kind, delta = struct.unpack_from("<BH", data, pos)
+            pos += 3
+            now += delta
+            payload = data[pos:pos + PAYLOAD.get(kind, 0)]
+            pos += len(payload)
+            if kind != WAIT:
+                log.entries.append((now, kind, payload))
+        return log
+
+
+def extract(capture):
+    log = Log()
+    for record in read_records([capture]):
+        if isinstance(record, str) or record.type != TLM_INPUT:
+            continue
+        kind = record.payload[0]
+        ms = struct.unpack_from("<I", record.payload, 1)[0]
+        if kind == SEED:
+            log.seed = struct.unpack_from("<I", record.payload, 5)[0]
+        else:
+            log.entries.append((ms, kind, bytes(record.payload[5:])))
+    return log
+
+
+def still(log, minutes, rng, start=0):
+    """MPU samples of a device lying on the desk"""
+    for ms in range(start, start + int(minutes * 60000), MPU_INTERVAL):
+        log.mpu(ms, rng.gauss(0, 0.05), rng.gauss(0, 0.05), GRAVITY + rng.gauss(0, 0.05))
+
+
+def synth(name, minutes):
+    rng = random.Random(name)
+    log = Log(seed=1234)
+    duration = int(minutes * 60000)
+
+    if name == "idle":
+        still(log, minutes, rng)
+
+    elif name == "petting":
+        still(log, minutes, rng)
+        for ms in range(SPLASH + 1000, duration, 3000):
+            log.tap(ms)
+            log.tap(ms + 150)
+
+    elif name == "shake":
+        for i, ms in enumerate(range(0, duration, MPU_INTERVAL)):
+            if (i // 5) % 2:
+                sign = 1 if i % 2 else -1
+                log.mpu(ms, sign * rng.uniform(16, 30), rng.uniform(-8, 8), GRAVITY + rng.uniform(-8, 8))
+            else:
+                log.mpu(ms, 0, 0, GRAVITY)
+
+    elif name == "flappy":
+        still(log, minutes, rng)
+        # three holds walk the menu from blink to flappy
+        ms = SPLASH + 1000
+        for _ in range(3):
+            log.tap(ms, 1000)
+            ms += 2000
+        # tap to start, then flap at a steady rhythm, any tap on the game over screen restarts
+        while ms < duration:
+            log.tap(ms)
+            ms += rng.choice([250, 300, 350, 400])
+
+    else:
+        raise SystemExit("unknown scenario " + name)
+
+    return log
+
+
+def dump(log):
+    print("seed %d, %d entries" % (log.seed, len(log.entries)))
+    for ms, kind, payload in log.entries:
+        if kind == MPU:
+            print("%9d  mpu %.2f %.2f %.2f" % ((ms,) + struct.unpack("<3f", payload)))
+        elif kind == TILT:
+            print("%9d  tilt %d %d %d" % ((ms,) + struct.unpack("<3h", payload)))
+        else:
+            print("%9d  edge %s" % (ms, "high" if kind == EDGE_HIGH else "low"))
+
+
+def header(data, source):
+    lines = ["// Generated by tools/replay.py from %s, do not edit" % source,
+             "const unsigned char scenario[%d] PROGMEM = {" % len(data)]
+    for i in range(0, len(data), 16):
+        lines.append("\t" + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("extract")
+    p.add_argument("capture")
+    p.add_argument("-o", "--output", required=True)
+
+    p = sub.add_parser("synth")
+    p.add_argument("scenario", choices=["idle", "petting", "shake", "flappy"])
+    p.add_argument("--minutes", type=float, default=10)
+    p.add_argument("-o", "--output", required=True)
+
+    p = sub.add_parser("dump")
+    p.add_argument("log")
+
+    p = sub.add_parser("header")
+    p.add_argument("log")
+    p.add_argument("-o", "--output", default="include/scenario.h")
+
+    args = parser.parse_args()
+
+    if args.command == "extract":
+        with open(args.capture, "rb") as f:
+            data = extract(f.read()).encode()
+    elif args.command == "synth":
+        data = synth(args.scenario, args.minutes).encode()
+    elif args.command == "dump":
+        with open(args.log, "rb") as f:
+            dump(Log.decode(f.read()))
+        return
+    else:
+        with open(args.log, "rb") as f:
+            data = f.read()
+        Log.decode(data)
+        with open(args.output, "w") as f:
+            f.write(header(data, args.log))
+        print("%d bytes written to %s" % (len(data), args.output))
+        return
+
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print("%d bytes written to %s" % (len(data), args.output))
+
+
+if __name__ == "__main__":
+    main()
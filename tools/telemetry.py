@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+Decoder for the MaoMao binary telemetry stream (see src/telemetry.h).
+
+    python tools/telemetry.py --port COM4              live log from the device
+    python tools/telemetry.py --port COM4 --save s.bin also keep the raw capture
+    python tools/telemetry.py s.bin                    decode a capture
+
+Plain text in between records (the 'p' profile dump) is passed through as is.
+"""
+import argparse
+import struct
+import sys
+
+SYNC = 0xA5
+BAUD = 921600
+
+TLM_LOG = 1
+TLM_DROPPED = 2
+TLM_TRACE = 3
+TLM_INPUT = 4
+TLM_SOAK = 5
+
+# Keep in sync with LogEvent in src/telemetry.h
+LOG_EVENTS = {
+    1: "boot",
+    2: "pressed once",
+    3: "pressed twice",
+    4: "pressed thrice",
+    5: "pressed hold",
+    6: "mode",
+    7: "menu",
+    8: "shake",
+    9: "game over",
+    10: "replay done",
+    11: "power",
+    12: "splash shown",
+    13: "first frame",
+    14: "boot failed",
+    15: "frames dropped",
+    16: "asset pack",
+}
+
+MODES = ["blink", "petting", "dizzy", "sleep", "sideeye", "study", "memes", "flappy", "splash", "eyes"]
+MENUS = ["blink", "sleep", "study", "flappy"]
+POWER_STATES = ["fast", "eco", "dim", "idle sleep"]
+
+
+class Record:
+    def __init__(self, type, time_us, payload):
+        self.type = type
+        self.time_us = time_us
+        self.payload = payload
+
+
+def _with_end(chunks):
+    for chunk in chunks:
+        yield chunk
+    yield None
+
+
+def read_records(chunks):
+    """
+    Yields Record objects and text strings from an iterable of byte chunks.
+    Timestamps are unwrapped, so they keep increasing past the 32 bit micros() overflow.
+    """
+    buf = bytearray()
+    text = bytearray()
+    last = None
+    wraps = 0
+
+    for chunk in _with_end(chunks):
+        end = chunk is None
+        if not end:
+            buf += chunk
+        while buf:
+            if buf[0] != SYNC:
+                text.append(buf.pop(0))
+                if text.endswith(b"\n"):
+                    yield text.decode(errors="replace")
+                    text.clear()
+                continue
+            if len(buf) < 3 or len(buf) < 4 + buf[2]:
+                if not end:
+                    break
+                # truncated record at the end of a capture
+                text.append(buf.pop(0))
+                continue
+
+            type, length = buf[1], buf[2]
+            body = bytes(buf[3:3 + length])
+            check = type ^ length
+            for b in body:
+                check ^= b
+            if length < 4 or check != buf[3 + length]:
+                # not a record after all, treat the sync byte as text and resync
+                text.append(buf.pop(0))
+                continue
+
+            del buf[:4 + length]
+            stamp = struct.unpack_from("<I", body)[0]
+            if last is not None and stamp < last:
+                wraps += 1
+            last = stamp
+            yield Record(type, stamp + (wraps << 32), body[4:])
+
+    if text:
+        yield text.decode(errors="replace")
+
+
+def describe(record):
+    if record.type == TLM_DROPPED:
+        return "*** %d records dropped ***" % struct.unpack("<H", record.payload)[0]
+    if record.type == TLM_LOG:
+        event, arg = struct.unpack("<Bi", record.payload)
+        name = LOG_EVENTS.get(event, "event %d" % event)
+        if event == 6:
+            return "%s %s" % (name, MODES[arg] if arg < len(MODES) else arg)
+        if event == 7:
+            return "%s %s" % (name, MENUS[arg] if arg < len(MENUS) else arg)
+        if event == 11:
+            return "%s %s" % (name, POWER_STATES[arg] if arg < len(POWER_STATES) else arg)
+        if event in (12, 13):
+            return "%s at %dms" % (name, arg)
+        if event == 14:
+            return "%s: %s" % (name, "display" if arg == 0 else "mpu")
+        if event == 15:
+            return "%s %d" % (name, arg)
+        if event == 16:
+            return "%s %s" % (name, "does not fit this firmware" if arg < 0 else "%d clips" % arg)
+        if event == 9:
+            return "%s score=%d" % (name, arg)
+        return name
+    if record.type == TLM_SOAK:
+        v = struct.unpack("<11I", record.payload)
+        return ("soak %ds frames=%d flushes=%d frame min/avg/max=%d/%d/%dus heap min=%d "
+                "games=%d last=%d best=%d avg=%d" % v)
+    if record.type == TLM_INPUT:
+        return "input kind %d at %dms" % (record.payload[0], struct.unpack_from("<I", record.payload, 1)[0])
+    if record.type == TLM_TRACE:
+        span, phase, arg = struct.unpack("<BcH", record.payload)
+        return "trace %d %s %d" % (span, phase.decode(), arg)
+    return "record type %d %s" % (record.type, record.payload.hex())
+
+
+def open_source(args):
+    if args.port:
+        import serial  # pyserial
+
+        port = serial.Serial(args.port, args.baud, timeout=0.1)
+        save = open(args.save, "wb") if args.save else None
+
+        def chunks():
+            while True:
+                data = port.read(4096)
+                if save and data:
+                    save.write(data)
+                    save.flush()
+                yield data
+
+        return chunks()
+
+    with open(args.capture, "rb") as f:
+        return [f.read()]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", nargs="?", help="raw capture file to decode")
+    parser.add_argument("--port", help="serial port to read live")
+    parser.add_argument("--baud", type=int, default=BAUD)
+    parser.add_argument("--save", help="write the raw stream to this file while reading live")
+    args = parser.parse_args()
+    if not args.port and not args.capture:
+        parser.error("give a capture file or --port")
+
+    previous = None
+    for item in read_records(open_source(args)):
+        if isinstance(item, str):
+            sys.stdout.write(item)
+            continue
+        delta = "" if previous is None else "+%.1fms" % ((item.time_us - previous) / 1000.0)
+        previous = item.time_us
+        print("%12.6f %10s  %s" % (item.time_us / 1e6, delta, describe(item)))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
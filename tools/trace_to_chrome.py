@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Converts a telemetry capture from a -DMAO_TRACE build into Chrome trace json.
+
+    python tools/telemetry.py --port COM4 --save session.bin
+    python tools/trace_to_chrome.py session.bin -o session.json
+
+Open the json in chrome://tracing or https://ui.perfetto.dev.
+"""
+import argparse
+import json
+import struct
+
+from telemetry import MODES, TLM_DROPPED, TLM_LOG, TLM_TRACE, describe, read_records
+
+# Keep in sync with TraceSpan in src/trace.h, (name, track)
+SPANS = {
+    1: ("frame", "loop"),
+    2: ("flush", "i2c"),
+    3: ("mpu poll", "i2c"),
+    4: ("irq", "irq"),
+    5: ("pause", "pacing"),
+    6: ("mode", "mode"),
+    7: ("buttons", "loop"),
+}
+
+TRACKS = ["loop", "i2c", "irq", "pacing", "mode", "log"]
+
+# Spans that can be restarted without an end event, a new begin closes the previous one
+EXCLUSIVE = {5, 6}
+
+
+def span_name(span, arg):
+    name = SPANS[span][0]
+    if span == 6:
+        return MODES[arg] if arg < len(MODES) else "mode %d" % arg
+    if span == 5:
+        return "%s %dms" % (name, arg)
+    return name
+
+
+def convert(records):
+    events = []
+    open_spans = {}
+    last_ts = 0
+
+    for tid, track in enumerate(TRACKS):
+        events.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": tid, "args": {"name": track}})
+
+    for record in records:
+        if isinstance(record, str):
+            continue
+        ts = record.time_us
+        last_ts = ts
+
+        if record.type == TLM_TRACE:
+            span, phase, arg = struct.unpack("<BcH", record.payload)
+            phase = phase.decode()
+            if span not in SPANS:
+                continue
+            tid = TRACKS.index(SPANS[span][1])
+
+            if phase == "B":
+                if span in EXCLUSIVE and span in open_spans:
+                    events.append({"ph": "E", "ts": ts, "pid": 1, "tid": tid})
+                open_spans[span] = ts
+                events.append({"ph": "B", "name": span_name(span, arg), "ts": ts, "pid": 1, "tid": tid})
+            elif phase == "E":
+                if span in open_spans:
+                    del open_spans[span]
+                    events.append({"ph": "E", "ts": ts, "pid": 1, "tid": tid})
+            else:
+                events.append({"ph": "i", "s": "t", "name": span_name(span, arg), "ts": ts, "pid": 1, "tid": tid})
+
+        elif record.type in (TLM_LOG, TLM_DROPPED):
+            events.append({"ph": "i", "s": "g" if record.type == TLM_DROPPED else "t",
+                           "name": describe(record), "ts": ts, "pid": 1, "tid": TRACKS.index("log")})
+
+    # close whatever is still running at the end of the capture
+    for span in open_spans:
+        events.append({"ph": "E", "ts": last_ts, "pid": 1, "tid": TRACKS.index(SPANS[span][1])})
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="raw capture saved with tools/telemetry.py --save")
+    parser.add_argument("-o", "--output", default="trace.json")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        trace = convert(read_records([f.read()]))
+
+    with open(args.output, "w") as f:
+        json.dump(trace, f)
+    print("%d events written to %s" % (len(trace["traceEvents"]), args.output))
+
+
+if __name__ == "__main__":
+    main()